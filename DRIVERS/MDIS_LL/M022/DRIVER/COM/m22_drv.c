@@ -13,13 +13,55 @@
  *   for the M24.
  *   An installed signal will be sent on interrupt. The IRQ-causing
  *   channel can be read via GetStat.
+ *   Each interrupt is also stored as time stamped event record in a
+ *   ring buffer, which can be read via M22_24_GETBLOCK_EVENTS.
+ *   Signals can be coalesced by a holdoff time and/or an edge count
+ *   threshold, the number of edges is read via M22_24_SIG_PENDING.
+ *   Alternatively M22_24_GETBLOCK_WAIT_EVENT blocks until the next event.
+ *   Several processes can subscribe signals for a subset of channels
+ *   and edges via M22_24_SETBLOCK_SIG_SUBSCRIBE.
+ *   Channels in counter mode count their input edges in the interrupt
+ *   routine without events or signals.
+ *   Channels in measurement mode measure the mean period per gate and
+ *   the frequency of their input edges (M22_24_MEAS_xxx).
+ *   The interrupt routine keeps statistics about its calls and, if built
+ *   with a cycle counter (M22_STAT_TIME), its execution time
+ *   (M22_24_GETBLOCK_IRQ_STATS).
+ *   Input edges can be debounced per channel (M22_24_DEBOUNCE_US): after
+ *   an edge the channel irq is disabled until the input is stable, a
+ *   level change is reported only when it settled.
+ *   In hybrid mode (M22_24_HYBRID_IRQ_RATE) the driver switches to
+ *   polling with a timer during irq storms and back to irqs when the
+ *   edge rate drops.
+ *   In polling mode (POLL_MODE) the driver doesn't use the module irq,
+ *   a timer collects the edges every POLL_PERIOD ms. The m22_nirq
+ *   variant doesn't request an irq from MDIS at all.
+ *   All channels can be read and the M22 outputs written as bit masks
+ *   with one call (M22_24_GETBLOCK_PORT, M22_PORT_OUTPUTS).
+ *   M22_PORT_OUTPUTS_MODIFY sets, clears and toggles outputs by masks
+ *   in one pass.
+ *   In block read mode M22_24_BLK_READ_DELTA, M22_BlockRead returns only
+ *   the channels changed since the last block read.
+ *   With M22_24_CACHED_READ, inputs with both edge irqs enabled are read
+ *   from an image maintained by the irq in scan irq mode, without
+ *   register access.
+ *   The output sequencer (M22_SETBLOCK_SEQ) replays timed output masks
+ *   on the M22 from a timer, optionally looped.
+ *   M22 outputs can be pulse width modulated by a timer (M22_PWM_PERIOD,
+ *   M22_PWM_DUTY) or switched on for a given time (M22_PULSE).
+ *   Several setstats can be applied with one call and a single irq
+ *   reconfiguration (M22_24_SETBLOCK_CONFIG).
+ *   The writable IOREG/ALARMREG bits are kept in a shadow, so updates
+ *   are single write cycles (M22_24_SHADOW_SYNC reloads it).
  *
  *   For detailed information on the M-Modules' capabilities see the
  *   respective hardware manuals.
  *
  *   Note: If two enabled channels are changing at the same time,
  *         the M-Module detects only one channel as the one causing the IRQ.
- *         To prevent loss of events, read all active channels.
+ *         To prevent loss of events, read all active channels or
+ *         use IRQ_MODE 1, where the interrupt routine scans the edge
+ *         occurred bits of all active channels.
  *
  *
  *	   Required: ---
@@ -63,6 +105,51 @@
 /*-----------------------------------------+
   |  TYPEDEFS								   |
   +------------------------------------------*/
+#define	M22_MAX_SUBSCR	8			/* max. number of signal subscribers */
+
+#define	M22_IRQ_HIST	16			/* = M22_24_IRQ_HIST_SIZE */
+
+#define	M22_CFG_MAX		64			/* = M22_24_CONFIG_MAX */
+
+#define	M22_SIG_HOLDOFF_DEF	100		/* holdoff [ms] of a threshold alone */
+
+/* polling states (pollActive) */
+#define	M22_POLL_OFF	0			/* interrupt driven */
+#define	M22_POLL_HYBRID	1			/* irq storm - polling until quiet */
+#define	M22_POLL_ALWAYS	2			/* polling mode, no irqs */
+
+/* signal subscriber */
+typedef struct
+{
+	OSS_SIG_HANDLE	*sigHdl;
+	int32			sigNo;
+	int32			processId;		/* owner process */
+	u_int32			chMask;			/* bit n = channel n */
+	u_int8			edgeMask;		/* M22_24_SUB_xxx */
+	u_int8			pending;		/* matching event since last signal */
+} M22_SUBSCR;
+
+/* output sequencer step */
+typedef struct
+{
+	u_int32			time;			/*	offset from loop start [ms] */
+	u_int32			mask;			/*	output switches */
+} M22_STEP;
+
+/* frequency/period measurement of a channel */
+typedef struct
+{
+	u_int32			gateStart;		/* tick of first edge in gate */
+	u_int32			edges;			/* edges in gate (incl. first) */
+	u_int32			lastTick;		/* tick of last edge */
+	u_int32			gateTicks;		/* length of last complete gate */
+	u_int32			gatePeriod;		/* mean period of last gate [us] */
+	u_int32			gatePeriodMin;	/* min./max. of gatePeriod */
+	u_int32			gatePeriodMax;
+	u_int32			freq;			/* smoothed frequency [mHz] */
+	u_int32			nbrGates;		/* completed gates */
+} M22_MEAS;
+
 typedef	struct
 {
 	int32			ownMemSize;
@@ -73,18 +160,143 @@ typedef	struct
 	MACCESS			ma;
 	OSS_SIG_HANDLE	*sigHdl;
 	OSS_IRQ_HANDLE	*irqHdl;
+	OSS_ALARM_HANDLE *sigAlarmHdl;	/* signal holdoff timer */
+	OSS_ALARM_HANDLE *debAlarmHdl;	/* debounce timer */
+	OSS_ALARM_HANDLE *pollAlarmHdl;	/* polling timer */
+	OSS_ALARM_HANDLE *seqAlarmHdl;	/* output sequencer timer */
+	OSS_ALARM_HANDLE *pwmAlarmHdl;	/* software PWM timer */
+	OSS_ALARM_HANDLE *pulseAlarmHdl; /* one-shot pulse timer */
+	OSS_SIG_HANDLE	*pulseSigHdl;	/* pulse done signal */
+	OSS_SEM_HANDLE	*devSemHdl;		/* device semaphore */
+	OSS_SEM_HANDLE	*waitSemHdl;	/* wait for event semaphore */
 	u_int32			irqCount;
 
 	int32			modId;			/*	M22	| M24 */
 	int32			modIdM22_R4;		/*	M22	with new power switches */
 	int32			nbrOfChannels;
 	int32			irqEnabled;
+	u_int32			irqMode;		/*	M22_24_IRQ_MODE_xxx */
 	u_int16			irqSource;		/*	IRQ-causing channel */
 	u_int8			activeCh[16];	    /*	active channels (ch 0..7..15) */
 	u_int8			inputEdgeMask[16];	/*	input edge masks (ch 0..7..15) */
 	u_int8			alarmEdgeMask[8];	/*	alarm edge masks (ch 0..7) */
 	u_int8			stateBuf[16];
 	u_int8			alarmStateBuf[8];
+	u_int8			ioShadow[16];		/*	writable IOREG bits */
+	u_int8			alarmShadow[8];		/*	writable ALARMREG bits */
+	u_int8			ioEdges[16];		/*	IOREG edge bits set at last read */
+	u_int8			alarmEdges[8];		/*	ALARMREG edge bits set at last read */
+
+	/* event ring buffer */
+	struct m22_24_event	*evBuf;		/*	event records */
+	u_int32			evBufGotSize;	/*	allocated size of evBuf */
+	u_int32			evMax;			/*	number of records in evBuf */
+	u_int32			evIn;			/*	next record to write (irq) */
+	u_int32			evOut;			/*	next record to read */
+	u_int32			evCount;		/*	number of buffered records */
+	u_int32			evLost;			/*	records lost by overflow */
+	u_int32			evSeqNbr;		/*	sequence number of next event */
+	u_int32			lastEvTime;		/*	last event (also without evBuf) */
+	u_int8			lastEvCh;
+	u_int8			lastEvFlags;
+	u_int32			waitCount;		/*	number of waiting callers */
+
+	/* signal subscribers */
+	M22_SUBSCR		subscr[M22_MAX_SUBSCR];
+	u_int32			subscrCount;
+
+	/* edge counters */
+	u_int8			counterMode[16];	/*	count input edges only */
+	u_int64			cntRising[16];
+	u_int64			cntFalling[16];
+
+	/* frequency/period measurement */
+	u_int8			measMode[16];	/*	M22_24_MEAS_xxx */
+	M22_MEAS		meas[16];
+	u_int32			measGate;		/*	gate time [ms] */
+	u_int32			measGateTicks;
+	u_int32			tickRate;		/*	OSS ticks per second */
+	u_int32			usPerTick;
+
+	/* interrupt statistics */
+	u_int32			irqChCount[16];	/*	irqs with edges per channel */
+	u_int32			irqSpurious;	/*	irqs without edge */
+	u_int32			sigSendErr;		/*	OSS_SigSend failures */
+	u_int32			isrTimeMin;		/*	ISR time [M22_STAT_TIME units] */
+	u_int32			isrTimeMax;
+	u_int64			isrTimeSum;
+	u_int32			isrTimeCnt;
+	u_int32			isrHist[M22_IRQ_HIST];	/*	log2 histogram of ISR time */
+	u_int32			scanHits;		/*	registers with edges found by scanReg */
+
+	/* debounce */
+	u_int32			debUs[16];		/*	debounce time [us], 0 = off */
+	u_int32			debTicks[16];	/*	debounce time [ticks] */
+	u_int32			debUntil[16];	/*	end of debounce window [tick] */
+	u_int8			debActive[16];	/*	debounce window open */
+	u_int8			debLevel[16];	/*	debounced (last reported) input level */
+	u_int32			debAlarmActive;	/*	debounce timer running */
+
+	/* polling / hybrid mode */
+	u_int32			pollMode;		/*	M22_24_POLL_MODE_xxx */
+	u_int32			pollActive;		/*	M22_POLL_xxx */
+	u_int32			pollPeriod;		/*	polling period [ms] */
+	u_int32			hybRate;		/*	irq rate to start polling [1/s], 0 = off */
+	u_int32			hybWinStart;	/*	irq rate window start [tick] */
+	u_int32			hybWinTicks;	/*	irq rate window length */
+	u_int32			hybWinIrqs;		/*	irqs in window */
+	u_int32			hybWinMax;		/*	max. irqs in window */
+	u_int32			hybQuiet;		/*	subsequent quiet polls */
+	u_int32			hybCount;		/*	switches to polling */
+
+	/* signal coalescing */
+	u_int32			sigHoldoff;		/*	holdoff time [ms], 0 = none */
+	u_int32			sigThreshold;	/*	edges per signal, 0/1 = each */
+	u_int32			sigHeld;		/*	edges not signalled yet */
+	u_int32			sigPending;		/*	edges since last M22_24_SIG_PENDING */
+	u_int32			sigAlarmActive;	/*	holdoff timer running */
+
+	/* block read */
+	u_int32			blkReadMode;	/*	M22_24_BLK_READ_xxx */
+	u_int8			deltaLast[16];	/*	state at last delta read */
+
+	/* cached input image */
+	u_int32			cachedRead;		/*	serve reads from image */
+	u_int8			imgLevel[16];	/*	input level (IOREG_INPUT_OR_ALARM_VAL) */
+	u_int8			imgValid[16];	/*	imgLevel is up to date */
+
+	/* output sequencer */
+	M22_STEP		*seqBuf;		/*	steps */
+	u_int32			seqGotSize;		/*	allocated size of seqBuf */
+	u_int32			seqNbr;			/*	number of steps */
+	u_int32			seqFlags;		/*	M22_SEQ_xxx */
+	u_int32			seqPeriodT;		/*	loop period, whole ticks */
+	u_int32			seqPeriodFrac;	/*	loop period, fraction [1/1000 tick] */
+	u_int32			seqStart;		/*	start of current loop [tick] */
+	u_int32			seqFrac;		/*	fraction of seqStart [1/1000 tick] */
+	u_int32			seqIdx;			/*	next step */
+	u_int32			seqState;		/*	M22_SEQ_IDLE/RUNNING/DONE */
+	u_int32			seqLoops;		/*	completed loops */
+	u_int32			seqUnderruns;	/*	steps output too late */
+
+	/* software PWM */
+	u_int32			pwmPeriod[8];	/*	period [ms], 0 = off */
+	u_int32			pwmDuty[8];		/*	duty cycle [1/1000] */
+	u_int32			pwmPeriodT[8];	/*	period [ticks], 0 = off */
+	u_int32			pwmOnT[8];		/*	on time [ticks] */
+	u_int32			pwmStart[8];	/*	start of current period [tick] */
+	u_int32			pwmAlarmActive;	/*	PWM timer running */
+
+	/* one-shot pulses */
+	u_int8			pulseActive[8];	/*	pulse output on */
+	u_int32			pulseEnd[8];	/*	end of pulse [tick] */
+	u_int32			pulseAlarmActive; /* pulse timer running */
+
+	/* vectored configuration */
+	u_int32			cfgDefer;		/*	collect irq reconfiguration */
+	u_int32			cfgDirty;		/*	channels to reconfigure, bit n = ch n */
+	u_int32			cfgNbr;			/*	entries of last transaction */
+	int32			cfgErr[M22_CFG_MAX]; /* errors of last transaction */
 } LL_HANDLE;
 
 /* include files which need LL_HANDLE */
@@ -123,6 +335,17 @@ static const char IdentString[]=MENT_XSTR(MAK_REVISION);
 
 #define	IRQ_ENABLE_MASK			(IOREG_IRQ_ENABLE_RISING_EDGE | IOREG_IRQ_ENABLE_FALLING_EDGE)
 #define	EDGE_OCCURRED_MASK		(IOREG_RISING_EDGE_OCCURRED | IOREG_FALLING_EDGE_OCCURRED)
+#define	IOREG_WRITABLE_MASK		(IOREG_OUTPUT_SWITCH | IRQ_ENABLE_MASK)	/* shadowed */
+#define	M22_DELTA_INVALID		0xff	/* deltaLast never matches a state */
+#define	M22_PWM_DUTY_DEF		500		/* default PWM duty cycle [1/1000] */
+#define	M22_PWM_MIN_TICKS		10		/* min. PWM period [ticks] */
+
+/* input image of channel is maintained by the irq (scan mode, both edges) */
+#define	M22_IMG_OK(h,ch)	\
+	( (h)->cachedRead && (h)->irqEnabled && (h)->activeCh[ch] && \
+	  (h)->irqMode == M22_24_IRQ_MODE_SCAN && \
+	  (h)->pollActive == M22_POLL_OFF && !(h)->debActive[ch] && \
+	  (h)->inputEdgeMask[ch] == IRQ_ENABLE_MASK )
 
 /* INTREG */
 #define	M22_IRQ_CH_NBR		0x0e
@@ -132,6 +355,28 @@ static const char IdentString[]=MENT_XSTR(MAK_REVISION);
 #define	M22_IRQ_DISABLE		0
 #define	M22_IRQ_ENABLE		1
 
+#define	M22_EVENT_BUF_SIZE	64			/* default number of event records */
+#define	M22_EVENT_BUF_MAX	(0xffffffff / sizeof(M22_24_EVENT))	/* max. records */
+#define	M22_MEAS_GATE		100			/* default measurement gate [ms] */
+#define	M22_POLL_PERIOD		10			/* default polling period [ms] */
+#define	M22_HYB_QUIET		4			/* quiet polls to enable irqs again */
+
+/* driver variant for carriers without irq line (driver_nirq.mak) */
+#ifdef M22_NO_IRQ
+#	define M22_USE_IRQ		0
+#else
+#	define M22_USE_IRQ		1
+#endif
+
+/* time base of the ISR statistics: a cycle counter of the target, e.g.
+   -D'M22_STAT_TIME(h)=...' -D'M22_STAT_TIME_RATE(h)=...' (units per second).
+   Without one the ISR time isn't measured (timeRate 0), the OSS tick is
+   far too coarse for it. */
+#ifndef M22_STAT_TIME
+#	define M22_STAT_TIME(llHdl)		0
+#	define M22_STAT_TIME_RATE(llHdl)	0
+#endif
+
 #ifdef DBG
 #	define errorStartStr	"*** ERROR - "
 #	define errorLineStr	" (line "
@@ -177,6 +422,56 @@ static int32 setStatBlock
  int32			   code,
  M_SETGETSTAT_BLOCK *blockStruct
  );
+static int32 pushEvent( LL_HANDLE *llHdl, u_int8 ch, u_int8 flags );
+static int32 storeEvent( LL_HANDLE *llHdl, u_int8 ch, u_int8 flags, u_int32 tick );
+static int32 scanReg( LL_HANDLE *llHdl, u_int8 ch, u_int8 alarm );
+static int32 scanEdges( LL_HANDLE *llHdl );
+static void scanFlush( LL_HANDLE *llHdl );
+static void notifyEdges( LL_HANDLE *llHdl, int32 nbrOfEdges );
+static void sigAlarm( void *arg );
+static int32 waitEvent( LL_HANDLE *llHdl, M22_24_WAIT *waitP );
+static int32 subscribe( LL_HANDLE *llHdl, M22_24_SUBSCRIBE *subP );
+static int32 unsubscribe( LL_HANDLE *llHdl, int32 sigNo );
+static void measEdge( LL_HANDLE *llHdl, u_int8 ch, u_int32 tick );
+static void measGet( LL_HANDLE *llHdl, u_int8 ch, M22_24_MEAS *measP );
+static void measGateSet( LL_HANDLE *llHdl, u_int32 gate );
+static void irqStatTime( LL_HANDLE *llHdl, u_int32 t );
+static void irqStatGet( LL_HANDLE *llHdl, M22_24_IRQ_STATS *statP );
+static void debounceStart( LL_HANDLE *llHdl, u_int8 ch, u_int8 flags, u_int32 tick );
+static void debounceSet( LL_HANDLE *llHdl, u_int8 ch, u_int32 us );
+static void debAlarm( void *arg );
+static void hybridSet( LL_HANDLE *llHdl, u_int32 rate );
+static void hybridCheck( LL_HANDLE *llHdl );
+static void pollStart( LL_HANDLE *llHdl, u_int32 state );
+static void pollStop( LL_HANDLE *llHdl );
+static void pollAlarm( void *arg );
+static void pollModeSet( LL_HANDLE *llHdl, u_int32 mode );
+static void portRead( LL_HANDLE *llHdl, M22_24_PORT *portP );
+static void portWrite( LL_HANDLE *llHdl, u_int32 mask );
+static void portModify( LL_HANDLE *llHdl, u_int32 masks );
+static void shadowWrite( LL_HANDLE *llHdl, u_int8 ch, u_int8 alarm, u_int8 clrEdges );
+static void shadowSync( LL_HANDLE *llHdl );
+static void outputSet( LL_HANDLE *llHdl, u_int8 ch, u_int8 on );
+static u_int8 ioRead( LL_HANDLE *llHdl, u_int8 ch );
+static u_int32 msToTicks( LL_HANDLE *llHdl, u_int32 msec );
+static u_int32 msToTicksRound( LL_HANDLE *llHdl, u_int32 msec );
+static u_int32 ticksToMs( LL_HANDLE *llHdl, u_int32 ticks );
+static int32 seqSet( LL_HANDLE *llHdl, M22_SEQ *seqP, int32 size );
+static void seqStop( LL_HANDLE *llHdl );
+static u_int32 seqDue( LL_HANDLE *llHdl, u_int32 msec );
+static void seqLoopAdd( LL_HANDLE *llHdl, u_int32 nbr );
+static void seqRun( LL_HANDLE *llHdl );
+static void seqAlarm( void *arg );
+static void seqStatusGet( LL_HANDLE *llHdl, M22_SEQ_STATUS *statP );
+static int32 pwmSet( LL_HANDLE *llHdl, u_int8 ch, u_int32 period, u_int32 duty );
+static void pwmStop( LL_HANDLE *llHdl );
+static void pwmRun( LL_HANDLE *llHdl );
+static void pwmAlarm( void *arg );
+static int32 pulseStart( LL_HANDLE *llHdl, u_int8 ch, u_int32 us );
+static void pulseStop( LL_HANDLE *llHdl );
+static void pulseRun( LL_HANDLE *llHdl );
+static void pulseAlarm( void *arg );
+static int32 configSet( LL_HANDLE *llHdl, M22_24_CONFIG *cfgP, int32 nbr );
 
 /*****************************	M22_Ident  **********************************
  *
@@ -211,6 +506,7 @@ static char* M22_Ident(	void ) /*nodoc*/
 static int32 M22_MemCleanup( LL_HANDLE	*llHdl	) /*nodoc*/
 {
 	int32		retCode;
+	int32		i;
 
 	/*--------------------------+
 	  | remove installed signal	|
@@ -218,6 +514,38 @@ static int32 M22_MemCleanup( LL_HANDLE	*llHdl	) /*nodoc*/
 	/* deinit lldrv	memory */
 	if(	llHdl->sigHdl != NULL )
 		OSS_SigRemove( llHdl->osHdl, &llHdl->sigHdl );
+	if(	llHdl->pulseSigHdl != NULL )
+		OSS_SigRemove( llHdl->osHdl, &llHdl->pulseSigHdl );
+
+	for( i = 0; i < M22_MAX_SUBSCR; i++ )
+		if( llHdl->subscr[i].sigHdl != NULL )
+			OSS_SigRemove( llHdl->osHdl, &llHdl->subscr[i].sigHdl );
+
+	/* remove timers */
+	if( llHdl->pulseAlarmHdl != NULL )
+		OSS_AlarmRemove( llHdl->osHdl, &llHdl->pulseAlarmHdl );
+	if( llHdl->pwmAlarmHdl != NULL )
+		OSS_AlarmRemove( llHdl->osHdl, &llHdl->pwmAlarmHdl );
+	if( llHdl->seqAlarmHdl != NULL )
+		OSS_AlarmRemove( llHdl->osHdl, &llHdl->seqAlarmHdl );
+	if( llHdl->sigAlarmHdl != NULL )
+		OSS_AlarmRemove( llHdl->osHdl, &llHdl->sigAlarmHdl );
+	if( llHdl->debAlarmHdl != NULL )
+		OSS_AlarmRemove( llHdl->osHdl, &llHdl->debAlarmHdl );
+	if( llHdl->pollAlarmHdl != NULL )
+		OSS_AlarmRemove( llHdl->osHdl, &llHdl->pollAlarmHdl );
+
+	/* remove semaphores */
+	if( llHdl->waitSemHdl != NULL )
+		OSS_SemRemove( llHdl->osHdl, &llHdl->waitSemHdl );
+
+	/* free event buffer */
+	if( llHdl->evBuf != NULL )
+		OSS_MemFree( llHdl->osHdl, (int8*) llHdl->evBuf, llHdl->evBufGotSize );
+
+	/* free sequencer steps */
+	if( llHdl->seqBuf != NULL )
+		OSS_MemFree( llHdl->osHdl, (int8*) llHdl->seqBuf, llHdl->seqGotSize );
 
 	/*-------------------------------------+
 	  | free low-level handle				   |
@@ -236,6 +564,10 @@ static int32 M22_MemCleanup( LL_HANDLE	*llHdl	) /*nodoc*/
  *
  *	Description:  Set up the irq enable on edge bits for
  *                ch, value, active channel and edge mask.
+ *                While polling the irqs are disabled.
+ *                Writes the registers from the shadow (no read).
+ *                Within a vectored configuration the channel is only
+ *                marked and reconfigured at its end.
  *
  *---------------------------------------------------------------------------
  *	Input......:  llHdl	  pointer to low-level driver data structure
@@ -254,19 +586,2420 @@ static void configureIrqForChannel /*nodoc*/
  int32  value
  )
 {
+	OSS_IRQ_STATE	irqState;
+
+	if( llHdl->cfgDefer )
+		{
+			llHdl->cfgDirty |= 1 << ch;
+			return;
+		}/*if*/
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+
+	/* input image must be reloaded */
+	llHdl->imgValid[ch] = 0;
+
 	/* disable IRQ first */
-	MCLRMASK_D16( llHdl->ma, IOREG(ch), IRQ_ENABLE_MASK );
+	llHdl->ioShadow[ch] &= ~IRQ_ENABLE_MASK;
+	if( llHdl->modId == M22_MOD_ID )
+		llHdl->alarmShadow[ch] &= ~IRQ_ENABLE_MASK;
+
+	/* polling - irqs stay off */
+	if( value && llHdl->activeCh[ch] && llHdl->pollActive == M22_POLL_OFF )
+		{
+			/* enable active channels (input irq stays off while debouncing) */
+			if( !llHdl->debActive[ch] )
+				llHdl->ioShadow[ch] |= llHdl->inputEdgeMask[ch];
+			if( llHdl->modId == M22_MOD_ID )
+				llHdl->alarmShadow[ch] |= llHdl->alarmEdgeMask[ch];
+		}/*if*/
+
+	shadowWrite( llHdl, (u_int8)ch, 0, 0 );
 	if( llHdl->modId == M22_MOD_ID )
-		MCLRMASK_D16( llHdl->ma, ALARMREG(ch), IRQ_ENABLE_MASK );
+		shadowWrite( llHdl, (u_int8)ch, 1, 0 );
+
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*configureIrqForChannel*/
+
+/*****************************	shadowWrite  ********************************
+ *
+ *	Description:  Writes IOREG/ALARMREG of a channel from the shadow of
+ *                its writable bits (output switch, irq enables) without
+ *                reading it first.
+ *                Edge occurred bits are cleared by writing 0. Like the
+ *                read-modify-write, only the edge bits seen set by the
+ *                last read (ioEdges/alarmEdges, taken with irq masked)
+ *                are written back as 1; an edge latched after that read
+ *                is cleared.
+ *
+ *		   Note:  Must be called from interrupt or with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl		pointer to low-level driver data structure
+ *				  ch		channel 0..7..15
+ *				  alarm		0 - IOREG, 1 - ALARMREG (M22 only)
+ *				  clrEdges	edge occurred bits to clear
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void shadowWrite /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int8	   ch,
+ u_int8	   alarm,
+ u_int8	   clrEdges
+ )
+{
+	if( alarm )
+		{
+			llHdl->alarmEdges[ch] &= ~clrEdges;
+			MWRITE_D16( llHdl->ma, ALARMREG(ch),
+						llHdl->alarmShadow[ch] | llHdl->alarmEdges[ch] );
+		}
+	else
+		{
+			llHdl->ioEdges[ch] &= ~clrEdges;
+			MWRITE_D16( llHdl->ma, IOREG(ch),
+						llHdl->ioShadow[ch] | llHdl->ioEdges[ch] );
+		}/*if*/
+}/*shadowWrite*/
+
+/*****************************	shadowSync  *********************************
+ *
+ *	Description:  Loads the register shadows and the output switch bits
+ *                of the state buffer from the hardware.
+ *
+ *		   Note:  Must be called with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void shadowSync /*nodoc*/
+(
+ LL_HANDLE *llHdl
+ )
+{
+	u_int8	ch, reg;
+
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		{
+			reg = (u_int8) MREAD_D16( llHdl->ma, IOREG(ch) );
+			llHdl->ioShadow[ch] = (u_int8)(reg & IOREG_WRITABLE_MASK);
+			llHdl->ioEdges[ch]	= (u_int8)(reg & EDGE_OCCURRED_MASK);
+			if( llHdl->ioShadow[ch] & IOREG_OUTPUT_SWITCH )
+				llHdl->stateBuf[ch] |= M22_READ_OUTPUT_SWITCH;
+			else
+				llHdl->stateBuf[ch] &= ~M22_READ_OUTPUT_SWITCH;
+
+			if( llHdl->modId == M22_MOD_ID )
+				{
+					reg = (u_int8) MREAD_D16( llHdl->ma, ALARMREG(ch) );
+					llHdl->alarmShadow[ch] = (u_int8)(reg & IRQ_ENABLE_MASK);
+					llHdl->alarmEdges[ch]  = (u_int8)(reg & EDGE_OCCURRED_MASK);
+				}/*if*/
+		}/*for*/
+}/*shadowSync*/
+
+/*****************************	outputSet  **********************************
+ *
+ *	Description:  Switches the output of a channel via the IOREG shadow
+ *                and updates the state buffer.
+ *
+ *		   Note:  Must be called from interrupt or with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ch	  channel 0..7
+ *				  on	  0 - off, 1 - on
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void outputSet /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int8	   ch,
+ u_int8	   on
+ )
+{
+	if( on )
+		{
+			llHdl->stateBuf[ch] |= M22_READ_OUTPUT_SWITCH;
+			llHdl->ioShadow[ch] |= IOREG_OUTPUT_SWITCH;
+		}
+	else
+		{
+			llHdl->stateBuf[ch] &= ~M22_READ_OUTPUT_SWITCH;
+			llHdl->ioShadow[ch] &= ~IOREG_OUTPUT_SWITCH;
+		}/*if*/
+
+	shadowWrite( llHdl, ch, 0, 0 );
+}/*outputSet*/
+
+/*****************************	ioRead  *************************************
+ *
+ *	Description:  Reads IOREG of a channel.
+ *                If the input image of the channel is valid (see
+ *                M22_IMG_OK), the value is built from the image and the
+ *                shadow without register access; the edge occurred bits
+ *                are 0 then (edges are taken by the irq).
+ *                Otherwise the register is read and the image loaded.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ch	  channel 0..7..15
+ *
+ *	Output.....:  return  IOREG value
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static u_int8 ioRead /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int8	   ch
+ )
+{
+	OSS_IRQ_STATE	irqState;
+	u_int8			reg;
+
+	if( !M22_IMG_OK( llHdl, ch ) )
+		return( (u_int8) MREAD_D16( llHdl->ma, IOREG(ch) ) );
+
+	if( llHdl->imgValid[ch] )
+		return( (u_int8)(llHdl->imgLevel[ch] | llHdl->ioShadow[ch]) );
+
+	/* load image - irq masked, so it can't be overwritten by an older value */
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	reg = (u_int8) MREAD_D16( llHdl->ma, IOREG(ch) );
+	llHdl->ioEdges[ch]	= (u_int8)(reg & EDGE_OCCURRED_MASK);
+	llHdl->imgLevel[ch] = (u_int8)(reg & IOREG_INPUT_OR_ALARM_VAL);
+	llHdl->imgValid[ch] = 1;
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+	return( reg );
+}/*ioRead*/
+
+/*****************************	edgeFlags  **********************************
+ *
+ *	Description:  Builds the event flags from an IOREG/ALARMREG value.
+ *                If the edge occurred bits don't tell the direction
+ *                (none or both set), the current level decides.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  reg	  IOREG/ALARMREG value
+ *				  enMask  irq enable mask of the channel
+ *
+ *	Output.....:  return  M22_24_READ_xxx flags
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static u_int8 edgeFlags /*nodoc*/
+(
+ u_int8 reg,
+ u_int8 enMask
+ )
+{
+	u_int8 level = (u_int8)((reg & IOREG_INPUT_OR_ALARM_VAL) ? M22_24_READ_INPUT : 0);
+	u_int8 edges = (u_int8)(((reg & EDGE_OCCURRED_MASK) >> 3) & enMask);
+
+	if( edges == 0 || edges == (M22_24_READ_RISING_EDGE | M22_24_READ_FALLING_EDGE) )
+		edges = level ? M22_24_READ_RISING_EDGE : M22_24_READ_FALLING_EDGE;
+
+	return( (u_int8)(level | edges) );
+}/*edgeFlags*/
+
+/*****************************	pushEvent  **********************************
+ *
+ *	Description:  Stores an edge as event (see storeEvent).
+ *                Input edges of debounced channels are not stored: the
+ *                first one opens the debounce window, debAlarm reports
+ *                the level change once it settled.
+ *
+ *		   Note:  Must be called from interrupt or with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ch	  channel 0..7..15
+ *				  flags	  M22_24_READ_xxx | M22_EV_ALARM
+ *
+ *	Output.....:  return  1 - event to notify, 0 - counted only
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static int32 pushEvent /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int8  ch,
+ u_int8  flags
+ )
+{
+	u_int32	tick = OSS_TickGet( llHdl->osHdl );
+
+	if( llHdl->debTicks[ch] && !(flags & M22_EV_ALARM) )
+		{
+			if( !llHdl->debActive[ch] )
+				debounceStart( llHdl, ch, flags, tick );
+			return( 0 );
+		}/*if*/
+
+	return( storeEvent( llHdl, ch, flags, tick ) );
+}/*pushEvent*/
+
+/*****************************	storeEvent  *********************************
+ *
+ *	Description:  Stores an event record as last event and into the
+ *                event ring buffer. If the buffer is full, the event is
+ *                counted as lost. Marks the subscribers whose filter
+ *                matches the event.
+ *                Input edges of counter mode channels are only counted.
+ *                Feeds the frequency/period measurement.
+ *
+ *		   Note:  Must be called from interrupt or with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ch	  channel 0..7..15
+ *				  flags	  M22_24_READ_xxx | M22_EV_ALARM
+ *				  tick	  OSS tick of the event
+ *
+ *	Output.....:  return  1 - event to notify, 0 - counted only
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static int32 storeEvent /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int8  ch,
+ u_int8  flags,
+ u_int32 tick
+ )
+{
+	M22_24_EVENT *ev;
+	M22_SUBSCR	 *sub;
+	u_int8		 kind;
+
+	/* measure frequency/period */
+	if( (flags & (llHdl->measMode[ch] << 1)) && !(flags & M22_EV_ALARM) )
+		measEdge( llHdl, ch, tick );
+
+	/* counter channels count input edges only */
+	if( llHdl->counterMode[ch] && !(flags & M22_EV_ALARM) )
+		{
+			if( flags & M22_24_READ_RISING_EDGE )
+				llHdl->cntRising[ch]++;
+			else
+				llHdl->cntFalling[ch]++;
+			return( 0 );
+		}/*if*/
+
+	llHdl->lastEvTime	= tick;
+	llHdl->lastEvCh		= ch;
+	llHdl->lastEvFlags	= flags;
+	llHdl->evSeqNbr++;
+
+	/* mark matching subscribers */
+	if( llHdl->subscrCount )
+		{
+			kind = (u_int8)((flags & M22_EV_ALARM) ? M22_SUB_ALARM : M22_24_SUB_INPUT);
+			for( sub = llHdl->subscr; sub < &llHdl->subscr[M22_MAX_SUBSCR]; sub++ )
+				{
+					if( sub->sigHdl != NULL
+						&& (sub->chMask & (1 << ch))
+						&& (sub->edgeMask & flags & (M22_24_SUB_RISING | M22_24_SUB_FALLING))
+						&& (sub->edgeMask & kind) )
+						sub->pending = 1;
+				}/*for*/
+		}/*if*/
+
+	if( llHdl->evBuf == NULL )
+		return( 1 );
+
+	if( llHdl->evCount == llHdl->evMax )
+		{
+			llHdl->evLost++;
+			return( 1 );
+		}/*if*/
+
+	ev = &llHdl->evBuf[llHdl->evIn];
+	ev->seqNbr		= llHdl->evSeqNbr - 1;
+	ev->timeStamp	= llHdl->lastEvTime;
+	ev->ch			= ch;
+	ev->flags		= flags;
+	ev->reserved	= 0;
+
+	if( ++llHdl->evIn == llHdl->evMax )
+		llHdl->evIn = 0;
+	llHdl->evCount++;
+
+	return( 1 );
+}/*storeEvent*/
+
+/*****************************	scanReg  ************************************
+ *
+ *	Description:  Checks the edge occurred bits of one IOREG/ALARMREG
+ *                with enabled edge irqs. Each pending edge is stored as
+ *                event, merged into the state buffer and cleared.
+ *                If both edges occurred, the current level decides
+ *                which one came first.
+ *
+ *		   Note:  Must be called from interrupt or with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ch	  channel 0..7..15
+ *				  alarm	  0 - IOREG, 1 - ALARMREG (M22 only)
+ *
+ *	Output.....:  return  number of edges to notify
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static int32 scanReg /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int8	   ch,
+ u_int8	   alarm
+ )
+{
+	int32	nbrOfEdges;
+	u_int8	reg, pend, level, enMask, evFlags;
+	u_int16	offs;
+
+	if( alarm )
+		{
+			offs	= ALARMREG(ch);
+			enMask	= llHdl->alarmEdgeMask[ch];
+			evFlags	= M22_EV_ALARM;
+		}
+	else
+		{
+			offs	= IOREG(ch);
+			enMask	= llHdl->inputEdgeMask[ch];
+			evFlags	= 0;
+		}/*if*/
+
+	if( !enMask || (!alarm && llHdl->debActive[ch]) )
+		return( 0 );
+
+	reg  = (u_int8) MREAD_D16( llHdl->ma, offs );
+	if( alarm )
+		llHdl->alarmEdges[ch] = (u_int8)(reg & EDGE_OCCURRED_MASK);
+	else
+		llHdl->ioEdges[ch]	  = (u_int8)(reg & EDGE_OCCURRED_MASK);
+
+	/* keep input image while all edges are seen */
+	if( !alarm && enMask == IRQ_ENABLE_MASK )
+		{
+			llHdl->imgLevel[ch] = (u_int8)(reg & IOREG_INPUT_OR_ALARM_VAL);
+			llHdl->imgValid[ch] = 1;
+		}/*if*/
+
+	pend = (u_int8)(((reg & EDGE_OCCURRED_MASK) >> 3) & enMask);
+	if( !pend )
+		return( 0 );
+
+	/* clear the found edges, keep them in state buffer */
+	shadowWrite( llHdl, ch, alarm, (u_int8)(pend << 3) );
+	if( alarm )
+		llHdl->alarmStateBuf[ch] |= pend;
+	else
+		llHdl->stateBuf[ch] |= pend;
+
+	level = (u_int8)((reg & IOREG_INPUT_OR_ALARM_VAL) ? M22_24_READ_INPUT : 0);
+	if( pend == (M22_24_READ_RISING_EDGE | M22_24_READ_FALLING_EDGE) )
+		{
+			/* pulse - the edge leading to the current level was the last one */
+			if( level )
+				{
+					nbrOfEdges	= pushEvent( llHdl, ch, (u_int8)(evFlags | M22_24_READ_FALLING_EDGE) );
+					nbrOfEdges += pushEvent( llHdl, ch, (u_int8)(evFlags | M22_24_READ_INPUT | M22_24_READ_RISING_EDGE) );
+				}
+			else
+				{
+					nbrOfEdges	= pushEvent( llHdl, ch, (u_int8)(evFlags | M22_24_READ_INPUT | M22_24_READ_RISING_EDGE) );
+					nbrOfEdges += pushEvent( llHdl, ch, (u_int8)(evFlags | M22_24_READ_FALLING_EDGE) );
+				}/*if*/
+		}
+	else
+		nbrOfEdges = pushEvent( llHdl, ch, (u_int8)(evFlags | level | pend) );
+
+	llHdl->scanHits++;
+	llHdl->irqSource = ch;
+	return( nbrOfEdges );
+}/*scanReg*/
+
+/*****************************	scanEdges  **********************************
+ *
+ *	Description:  Scans the edge occurred bits of all active channels
+ *                (see scanReg). Counts the channels with edges in
+ *                irqChCount (per irq or poll).
+ *
+ *		   Note:  Must be called from interrupt or with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *
+ *	Output.....:  return  number of edges to notify
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static int32 scanEdges /*nodoc*/
+(
+ LL_HANDLE *llHdl
+ )
+{
+	int32	nbrOfEdges = 0;
+	u_int32	hits;
+	u_int8	ch;
+
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		{
+			if( !llHdl->activeCh[ch] )
+				continue;
+
+			hits = llHdl->scanHits;
+			nbrOfEdges += scanReg( llHdl, ch, 0 );
+			if( llHdl->modId == M22_MOD_ID )
+				nbrOfEdges += scanReg( llHdl, ch, 1 );
+			if( hits != llHdl->scanHits )
+				llHdl->irqChCount[ch]++;
+		}/*for*/
+
+	return( nbrOfEdges );
+}/*scanEdges*/
+
+/*****************************	scanFlush  **********************************
+ *
+ *	Description:  Takes the edge occurred bits latched before scan mode
+ *                into the state buffers and clears them without events.
+ *                In INTREG mode these edges are already reported, so
+ *                the first scan must not report them again.
+ *
+ *		   Note:  Must be called with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void scanFlush /*nodoc*/
+(
+ LL_HANDLE *llHdl
+ )
+{
+	u_int8	ch, alarm, reg, pend;
+
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		{
+			if( !llHdl->activeCh[ch] )
+				continue;
+
+			for( alarm = 0; alarm < (llHdl->modId == M22_MOD_ID ? 2 : 1); alarm++ )
+				{
+					reg	 = (u_int8) MREAD_D16( llHdl->ma, alarm ? ALARMREG(ch) : IOREG(ch) );
+					pend = (u_int8)((reg & EDGE_OCCURRED_MASK) >> 3);
+					if( alarm )
+						llHdl->alarmEdges[ch] = (u_int8)(reg & EDGE_OCCURRED_MASK);
+					else
+						llHdl->ioEdges[ch]	  = (u_int8)(reg & EDGE_OCCURRED_MASK);
+					if( !pend )
+						continue;
+
+					shadowWrite( llHdl, ch, alarm, (u_int8)(pend << 3) );
+					if( alarm )
+						llHdl->alarmStateBuf[ch] |= pend;
+					else
+						llHdl->stateBuf[ch] |= pend;
+				}/*for*/
+		}/*for*/
+}/*scanFlush*/
+
+/*****************************	notifyEdges  ********************************
+ *
+ *	Description:  Wakes up waiting callers and sends the installed
+ *                signal and the signals of matching subscribers for
+ *                detected edges.
+ *                Without coalescing the signal is sent at once.
+ *                Otherwise the edges are collected until the threshold
+ *                is reached or the holdoff time (started by the first
+ *                collected edge) has expired. A threshold without holdoff
+ *                uses M22_SIG_HOLDOFF_DEF, so remaining edges are not held
+ *                forever.
+ *
+ *		   Note:  Must be called from interrupt or with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl		  pointer to low-level driver data structure
+ *				  nbrOfEdges  number of new edges, 0 on holdoff expiry
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void notifyEdges /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ int32	   nbrOfEdges
+ )
+{
+	u_int32		realMsec, holdoff;
+	M22_SUBSCR	*sub;
+
+	/* wake up M22_24_GETBLOCK_WAIT_EVENT callers at once */
+	if( nbrOfEdges && llHdl->waitCount )
+		OSS_SemSignal( llHdl->osHdl, llHdl->waitSemHdl );
+
+	llHdl->sigPending += nbrOfEdges;
+	llHdl->sigHeld	  += nbrOfEdges;
+
+	if( !llHdl->sigHeld )
+		return;
+
+	/* wait for more edges (threshold not reached or holdoff only)? */
+	if( nbrOfEdges &&
+		(llHdl->sigThreshold ? llHdl->sigHeld < llHdl->sigThreshold : llHdl->sigHoldoff != 0) )
+		{
+			if( !llHdl->sigAlarmActive )
+				{
+					holdoff = llHdl->sigHoldoff ? llHdl->sigHoldoff : M22_SIG_HOLDOFF_DEF;
+					llHdl->sigAlarmActive = 1;
+					OSS_AlarmSet( llHdl->osHdl, llHdl->sigAlarmHdl, holdoff, 0, &realMsec );
+				}/*if*/
+			return;
+		}/*if*/
+
+	llHdl->sigHeld = 0;
+	if(	llHdl->sigHdl != NULL )
+		if(	OSS_SigSend( llHdl->osHdl,	llHdl->sigHdl ) )
+			{
+				llHdl->sigSendErr++;
+				IDBGWRT_ERR( ( DBH,	">>>  M22 notifyEdges: OSS_SigSend failed\n") );
+			}/*if*/
+
+	/* subscribers with matching edges */
+	if( llHdl->subscrCount )
+		for( sub = llHdl->subscr; sub < &llHdl->subscr[M22_MAX_SUBSCR]; sub++ )
+			{
+				if( !sub->pending )
+					continue;
+				sub->pending = 0;
+				if(	OSS_SigSend( llHdl->osHdl,	sub->sigHdl ) )
+					{
+						llHdl->sigSendErr++;
+						IDBGWRT_ERR( ( DBH,	">>>  M22 notifyEdges: OSS_SigSend failed\n") );
+					}/*if*/
+			}/*for*/
+}/*notifyEdges*/
+
+/*****************************	sigAlarm  ***********************************
+ *
+ *	Description:  Signal holdoff timer function.
+ *                Sends the signal for the collected edges.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  arg	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void sigAlarm /*nodoc*/
+(
+ void *arg
+ )
+{
+	LL_HANDLE		*llHdl = (LL_HANDLE*)arg;
+	OSS_IRQ_STATE	irqState;
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	llHdl->sigAlarmActive = 0;
+	notifyEdges( llHdl, 0 );
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*sigAlarm*/
+
+/*****************************	waitEvent  **********************************
+ *
+ *	Description:  Waits for the next event.
+ *                With event buffer the oldest buffered event is removed
+ *                and returned, without it the next new event is returned.
+ *                The device semaphore is released while waiting, so other
+ *                calls to the device are not blocked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	   pointer to low-level driver data structure
+ *				  waitP	   timeout [ms], 0 = no wait, -1 = endless
+ *
+ *	Output.....:  waitP	   event
+ *				  return   0 | ERR_OSS_TIMEOUT | error code
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static int32 waitEvent /*nodoc*/
+(
+ LL_HANDLE	 *llHdl,
+ M22_24_WAIT *waitP
+ )
+{
+	int32			error = 0;
+	int32			timeout = waitP->timeout;
+	u_int32			startSeqNbr, startTick, elapsed, rate;
+	OSS_IRQ_STATE	irqState;
+
+	startTick = OSS_TickGet( llHdl->osHdl );
+	irqState  = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	startSeqNbr = llHdl->evSeqNbr;
+
+	for(;;)
+		{
+			/*--------------------+
+			  | event available?  |
+			  +--------------------*/
+			if( llHdl->evBuf != NULL && llHdl->evCount )
+				{
+					waitP->ev = llHdl->evBuf[llHdl->evOut];
+					if( ++llHdl->evOut == llHdl->evMax )
+						llHdl->evOut = 0;
+					llHdl->evCount--;
+					/* more events for more waiters */
+					if( llHdl->evCount && llHdl->waitCount )
+						OSS_SemSignal( llHdl->osHdl, llHdl->waitSemHdl );
+					break;
+				}/*if*/
+
+			if( llHdl->evBuf == NULL && llHdl->evSeqNbr != startSeqNbr )
+				{
+					waitP->ev.seqNbr	= llHdl->evSeqNbr - 1;
+					waitP->ev.timeStamp	= llHdl->lastEvTime;
+					waitP->ev.ch		= llHdl->lastEvCh;
+					waitP->ev.flags		= llHdl->lastEvFlags;
+					waitP->ev.reserved	= 0;
+					/* all waiters get the event */
+					if( llHdl->waitCount )
+						OSS_SemSignal( llHdl->osHdl, llHdl->waitSemHdl );
+					break;
+				}/*if*/
+
+			if( timeout == 0 )
+				{
+					error = ERR_OSS_TIMEOUT;
+					break;
+				}/*if*/
+
+			/*--------------------+
+			  | wait			  |
+			  +--------------------*/
+			llHdl->waitCount++;
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+			if( llHdl->devSemHdl != NULL )
+				OSS_SemSignal( llHdl->osHdl, llHdl->devSemHdl );
+			error = OSS_SemWait( llHdl->osHdl, llHdl->waitSemHdl, timeout );
+			if( llHdl->devSemHdl != NULL )
+				OSS_SemWait( llHdl->osHdl, llHdl->devSemHdl, OSS_SEM_WAITFOREVER );
+
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			llHdl->waitCount--;
+
+			if( error == ERR_OSS_TIMEOUT )
+				timeout = 0;		/* check for event a last time */
+			else if( error )
+				break;
+			else if( timeout > 0 )
+				{
+					/* remaining time after wakeup without (own) event,
+					   split to avoid overflow of ticks * 1000 */
+					elapsed = OSS_TickGet( llHdl->osHdl ) - startTick;
+					rate	= OSS_TickRateGet( llHdl->osHdl );
+					elapsed = (elapsed / rate) * 1000 + ((elapsed % rate) * 1000) / rate;
+					timeout = (elapsed < (u_int32)waitP->timeout) ? waitP->timeout - (int32)elapsed : 0;
+				}/*if*/
+			error = 0;
+		}/*for*/
+
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+	return( error );
+}/*waitEvent*/
+
+/*****************************	subscribe  **********************************
+ *
+ *	Description:  Installs a signal for the calling process, which is
+ *                only sent for edges matching the channel and edge mask.
+ *                An existing subscription of the process with the same
+ *                signal number gets the new masks.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	   pointer to low-level driver data structure
+ *				  subP	   signal number, channel and edge mask
+ *
+ *	Output.....:  return   0 | error code
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static int32 subscribe /*nodoc*/
+(
+ LL_HANDLE		  *llHdl,
+ M22_24_SUBSCRIBE *subP
+ )
+{
+	DBGCMD(	static const char functionName[] = "LL - subscribe:"; )
+	int32			error, sigNo, processId;
+	OSS_SIG_HANDLE	*sigHdl = NULL;
+	M22_SUBSCR		*sub, *freeSub = NULL;
+	u_int32			chMask	 = subP->chMask ? subP->chMask : 0xffff;
+	u_int8			edgeMask = (u_int8)subP->edgeMask;
+	OSS_IRQ_STATE	irqState;
+
+	if( !(edgeMask & (M22_24_SUB_RISING | M22_24_SUB_FALLING)) )
+		edgeMask |= M22_24_SUB_RISING | M22_24_SUB_FALLING;
+	if( !(edgeMask & (M22_24_SUB_INPUT | M22_SUB_ALARM)) )
+		edgeMask |= M22_24_SUB_INPUT | M22_SUB_ALARM;
+
+	error = OSS_SigCreate( llHdl->osHdl, subP->sigNo, &sigHdl );
+	if( error )
+		return( error );
+	OSS_SigInfo( llHdl->osHdl, sigHdl, &sigNo, &processId );
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	for( sub = llHdl->subscr; sub < &llHdl->subscr[M22_MAX_SUBSCR]; sub++ )
+		{
+			if( sub->sigHdl == NULL )
+				{
+					if( freeSub == NULL )
+						freeSub = sub;
+				}
+			else if( sub->processId == processId && sub->sigNo == sigNo )
+				{
+					/* update existing subscription */
+					sub->chMask	  = chMask;
+					sub->edgeMask = edgeMask;
+					OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+					OSS_SigRemove( llHdl->osHdl, &sigHdl );
+					return( 0 );
+				}/*if*/
+		}/*for*/
+
+	if( freeSub == NULL )
+		{
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			OSS_SigRemove( llHdl->osHdl, &sigHdl );
+			DBGWRT_ERR( ( DBH, "%s%s: subscriber table full %s%d%s",
+						  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+			return( ERR_OSS_SIG_SET );
+		}/*if*/
+
+	freeSub->sigNo		= sigNo;
+	freeSub->processId	= processId;
+	freeSub->chMask		= chMask;
+	freeSub->edgeMask	= edgeMask;
+	freeSub->pending	= 0;
+	freeSub->sigHdl		= sigHdl;
+	llHdl->subscrCount++;
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+	return( 0 );
+}/*subscribe*/
+
+/*****************************	unsubscribe  ********************************
+ *
+ *	Description:  Removes the subscription of the calling process with
+ *                the given signal number.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	   pointer to low-level driver data structure
+ *				  sigNo	   signal number
+ *
+ *	Output.....:  return   0 | error code
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static int32 unsubscribe /*nodoc*/
+(
+ LL_HANDLE	*llHdl,
+ int32		sigNo
+ )
+{
+	DBGCMD(	static const char functionName[] = "LL - unsubscribe:"; )
+	int32			error, dummy, processId;
+	OSS_SIG_HANDLE	*sigHdl = NULL;
+	M22_SUBSCR		*sub;
+	OSS_IRQ_STATE	irqState;
+
+	/* temporary signal handle to identify the calling process */
+	error = OSS_SigCreate( llHdl->osHdl, sigNo, &sigHdl );
+	if( error )
+		return( error );
+	OSS_SigInfo( llHdl->osHdl, sigHdl, &dummy, &processId );
+	OSS_SigRemove( llHdl->osHdl, &sigHdl );
+
+	for( sub = llHdl->subscr; sub < &llHdl->subscr[M22_MAX_SUBSCR]; sub++ )
+		{
+			if( sub->sigHdl == NULL || sub->processId != processId || sub->sigNo != sigNo )
+				continue;
+
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			sigHdl = sub->sigHdl;
+			sub->sigHdl = NULL;
+			llHdl->subscrCount--;
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+			return( OSS_SigRemove( llHdl->osHdl, &sigHdl ) );
+		}/*for*/
+
+	DBGWRT_ERR( ( DBH, "%s%s: no subscription for signal %d %s%d%s",
+				  errorStartStr, functionName, sigNo, errorLineStr, __LINE__, errorEndStr ));
+	return( ERR_LL_ILL_PARAM );
+}/*unsubscribe*/
+
+/*****************************	measEdge  ***********************************
+ *
+ *	Description:  Frequency/period measurement of a channel.
+ *                The edges are counted during a gate of at least
+ *                measGateTicks. The first edge after the gate completes
+ *                it: the mean period and the frequency of the gate are
+ *                computed from the number of edges and the elapsed ticks,
+ *                so frequencies above the tick rate are measured as well.
+ *                The frequency is smoothed (1/4 of each new value).
+ *
+ *		   Note:  Called from interrupt or with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ch	  channel 0..7..15
+ *				  tick	  OSS tick of the edge
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void measEdge /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int8	   ch,
+ u_int32   tick
+ )
+{
+	M22_MEAS *m = &llHdl->meas[ch];
+	u_int32	 elapsed, periods, period, freq, q;
+
+	m->lastTick = tick;
+
+	if( m->edges++ == 0 )
+		{
+			m->gateStart = tick;
+			return;
+		}/*if*/
+
+	elapsed = tick - m->gateStart;
+	if( elapsed < llHdl->measGateTicks )
+		return;
+
+	/* mean period [us] and frequency [mHz] of the gate (no 64-bit division) */
+	periods = m->edges - 1;
+	period	= (elapsed / periods) * llHdl->usPerTick
+		+ ((elapsed % periods) * llHdl->usPerTick) / periods;
+	q		= periods * llHdl->tickRate;
+	freq	= (q / elapsed) * 1000 + ((q % elapsed) * 1000) / elapsed;
+
+	m->gatePeriod = period;
+	if( m->nbrGates == 0 )
+		{
+			m->gatePeriodMin = period;
+			m->gatePeriodMax = period;
+			m->freq		 = freq;
+		}
+	else
+		{
+			if( period < m->gatePeriodMin )
+				m->gatePeriodMin = period;
+			if( period > m->gatePeriodMax )
+				m->gatePeriodMax = period;
+			m->freq = m->freq - (m->freq >> 2) + (freq >> 2);
+		}/*if*/
+
+	m->gateTicks = elapsed;
+	m->nbrGates++;
+
+	/* this edge starts the next gate */
+	m->gateStart = tick;
+	m->edges	 = 1;
+}/*measEdge*/
+
+/*****************************	measGet  ************************************
+ *
+ *	Description:  Gets the measurement results of a channel.
+ *                The frequency reads 0 if no edge occurred for two
+ *                gates plus two periods of the last gate.
+ *
+ *		   Note:  Must be called with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ch	  channel 0..7..15
+ *				  measP	  result
+ *
+ *	Output.....:  *measP  result
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void measGet /*nodoc*/
+(
+ LL_HANDLE	 *llHdl,
+ u_int8		 ch,
+ M22_24_MEAS *measP
+ )
+{
+	M22_MEAS *m = &llHdl->meas[ch];
+
+	measP->gatePeriod		= m->gatePeriod;
+	measP->gatePeriodMin	= m->gatePeriodMin;
+	measP->gatePeriodMax	= m->gatePeriodMax;
+	measP->freq			= m->freq;
+	measP->nbrGates		= m->nbrGates;
+
+	if( m->nbrGates &&
+		(OSS_TickGet( llHdl->osHdl ) - m->lastTick) >
+		2 * (m->gateTicks + llHdl->measGateTicks) )
+		measP->freq = 0;
+}/*measGet*/
+
+/*****************************	measGateSet  ********************************
+ *
+ *	Description:  Sets the measurement gate time.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  gate	  gate time [ms]
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void measGateSet /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   gate
+ )
+{
+	llHdl->measGate		 = gate;
+	llHdl->measGateTicks = (gate * llHdl->tickRate) / 1000;
+	if( llHdl->measGateTicks == 0 )
+		llHdl->measGateTicks = 1;
+}/*measGateSet*/
+
+/*****************************	irqStatTime  ********************************
+ *
+ *	Description:  Accounts the execution time of one M22_Irq() call.
+ *                Histogram bin 0 counts t = 0, bin n counts
+ *                2^(n-1) <= t < 2^n, the last bin all longer times.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  t		  ISR time [M22_STAT_TIME units]
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void irqStatTime /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   t
+ )
+{
+	u_int32	bin, v;
+
+	if( llHdl->isrTimeCnt == 0 || t < llHdl->isrTimeMin )
+		llHdl->isrTimeMin = t;
+	if( t > llHdl->isrTimeMax )
+		llHdl->isrTimeMax = t;
+	llHdl->isrTimeSum += t;
+	llHdl->isrTimeCnt++;
+
+	for( bin = 0, v = t; v && bin < M22_IRQ_HIST - 1; bin++ )
+		v >>= 1;
+	llHdl->isrHist[bin]++;
+}/*irqStatTime*/
+
+/*****************************	irqStatGet  *********************************
+ *
+ *	Description:  Gets the interrupt statistics.
+ *
+ *		   Note:  Must be called with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  statP	  result
+ *
+ *	Output.....:  *statP  result
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void irqStatGet /*nodoc*/
+(
+ LL_HANDLE		  *llHdl,
+ M22_24_IRQ_STATS *statP
+ )
+{
+	u_int64	sum = llHdl->isrTimeSum;
+	u_int32	cnt = llHdl->isrTimeCnt;
+	int32	i;
+
+	statP->irqCount		= llHdl->irqCount;
+	statP->irqSpurious	= llHdl->irqSpurious;
+	statP->sigSendErr	= llHdl->sigSendErr;
+	statP->timeRate		= M22_STAT_TIME_RATE( llHdl );
+	statP->timeMin		= llHdl->isrTimeMin;
+	statP->timeMax		= llHdl->isrTimeMax;
+
+	/* average without 64-bit division */
+	while( sum >> 32 )
+		{
+			sum >>= 1;
+			cnt >>= 1;
+		}/*while*/
+	statP->timeAvg = cnt ? (u_int32)sum / cnt : 0;
+
+	for( i = 0; i < M22_24_IRQ_HIST_SIZE; i++ )
+		statP->timeHist[i] = llHdl->isrHist[i];
+	for( i = 0; i < 16; i++ )
+		statP->chIrqCount[i] = i < llHdl->nbrOfChannels ? llHdl->irqChCount[i] : 0;
+}/*irqStatGet*/
+
+/*****************************	debounceStart  ******************************
+ *
+ *	Description:  Opens the debounce window of a channel after an input
+ *                edge. The edge isn't reported yet (see debAlarm).
+ *                The input edge irqs of the channel are disabled and the
+ *                edge occurred bits are cleared. The level before the
+ *                edge is the last reported one, with only one edge
+ *                enabled it is given by that edge.
+ *
+ *		   Note:  Called from interrupt or with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ch	  channel 0..7..15
+ *				  flags	  M22_24_READ_xxx of the edge
+ *				  tick	  OSS tick of the edge
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void debounceStart /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int8	   ch,
+ u_int8	   flags,
+ u_int32   tick
+ )
+{
+	u_int32	realMsec, msec;
+
+	/* disable edge irqs, clear edges */
+	llHdl->ioShadow[ch] &= ~IRQ_ENABLE_MASK;
+	shadowWrite( llHdl, ch, 0, EDGE_OCCURRED_MASK );
+
+	if( llHdl->inputEdgeMask[ch] != IRQ_ENABLE_MASK )
+		llHdl->debLevel[ch] = (u_int8)((flags & M22_24_READ_RISING_EDGE) ? 0 : M22_24_READ_INPUT);
+	llHdl->debUntil[ch]	 = tick + llHdl->debTicks[ch];
+	llHdl->debActive[ch] = 1;
+	llHdl->imgValid[ch]	 = 0;
+
+	/* check windows each tick */
+	if( !llHdl->debAlarmActive )
+		{
+			msec = 1000 / llHdl->tickRate;
+			llHdl->debAlarmActive = 1;
+			OSS_AlarmSet( llHdl->osHdl, llHdl->debAlarmHdl, msec ? msec : 1, 0, &realMsec );
+		}/*if*/
+}/*debounceStart*/
+
+/*****************************	debounceSet  ********************************
+ *
+ *	Description:  Sets the debounce time of a channel.
+ *                Switching debouncing on takes the current input level
+ *                as debounced level, an open window is closed when
+ *                debouncing is switched off.
+ *
+ *		   Note:  Must be called with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ch	  channel 0..7..15
+ *				  us	  debounce time [us], 0 = off
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void debounceSet /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int8	   ch,
+ u_int32   us
+ )
+{
+	u_int8	reg;
+
+	if( us && !llHdl->debTicks[ch] )
+		{
+			reg = (u_int8) MREAD_D16( llHdl->ma, IOREG(ch) );
+			llHdl->debLevel[ch] = (u_int8)((reg & IOREG_INPUT_OR_ALARM_VAL) ? M22_24_READ_INPUT : 0);
+		}/*if*/
+
+	llHdl->debUs[ch]	= us;
+	llHdl->debTicks[ch] = (us + llHdl->usPerTick - 1) / llHdl->usPerTick;
+
+	if( !us && llHdl->debActive[ch] )
+		{
+			llHdl->debActive[ch] = 0;
+			configureIrqForChannel( llHdl, ch, llHdl->irqEnabled );
+		}/*if*/
+}/*debounceSet*/
+
+/*****************************	debAlarm  ***********************************
+ *
+ *	Description:  Debounce timer function.
+ *                Checks the expired debounce windows. An edge within the
+ *                window restarts it. Otherwise the input settled: the
+ *                edge irqs are enabled again and, if the level differs
+ *                from the debounced level, it is reported as edge.
+ *                So a glitch shorter than the window isn't reported.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  arg	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void debAlarm /*nodoc*/
+(
+ void *arg
+ )
+{
+	LL_HANDLE		*llHdl = (LL_HANDLE*)arg;
+	OSS_IRQ_STATE	irqState;
+	u_int32			tick, realMsec, msec;
+	int32			nbrOfEdges = 0;
+	u_int8			ch, reg, level, flags, active = 0;
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	llHdl->debAlarmActive = 0;
+	tick = OSS_TickGet( llHdl->osHdl );
+
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		{
+			if( !llHdl->debActive[ch] )
+				continue;
+			if( (int32)(tick - llHdl->debUntil[ch]) < 0 )
+				{
+					active++;
+					continue;
+				}/*if*/
+
+			reg = (u_int8) MREAD_D16( llHdl->ma, IOREG(ch) );
+			llHdl->ioEdges[ch] = (u_int8)(reg & EDGE_OCCURRED_MASK);
+			if( reg & EDGE_OCCURRED_MASK )
+				{
+					/* bounced - wait again */
+					shadowWrite( llHdl, ch, 0, EDGE_OCCURRED_MASK );
+					llHdl->debUntil[ch] = tick + llHdl->debTicks[ch];
+					active++;
+					continue;
+				}/*if*/
+
+			/* settled - enable irq */
+			llHdl->debActive[ch] = 0;
+			configureIrqForChannel( llHdl, ch, llHdl->irqEnabled );
+
+			level = (u_int8)((reg & IOREG_INPUT_OR_ALARM_VAL) ? M22_24_READ_INPUT : 0);
+			if( level == llHdl->debLevel[ch] )
+				continue;			/* glitch */
+
+			/* level changed - report it */
+			llHdl->debLevel[ch] = level;
+			flags = (u_int8)(level ? (M22_24_READ_INPUT | M22_24_READ_RISING_EDGE)
+							 : M22_24_READ_FALLING_EDGE);
+			if( flags & llHdl->inputEdgeMask[ch] )
+				{
+					llHdl->stateBuf[ch] |= (u_int8)(flags & (M22_24_READ_RISING_EDGE | M22_24_READ_FALLING_EDGE));
+					nbrOfEdges += storeEvent( llHdl, ch, flags, tick );
+				}/*if*/
+		}/*for*/
+
+	if( active && !llHdl->debAlarmActive )
+		{
+			msec = 1000 / llHdl->tickRate;
+			llHdl->debAlarmActive = 1;
+			OSS_AlarmSet( llHdl->osHdl, llHdl->debAlarmHdl, msec ? msec : 1, 0, &realMsec );
+		}/*if*/
+
+	if( nbrOfEdges )
+		notifyEdges( llHdl, nbrOfEdges );
+
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*debAlarm*/
+
+/*****************************	hybridSet  **********************************
+ *
+ *	Description:  Sets the irq rate to switch from interrupts to polling.
+ *                The rate is checked in windows of 100ms.
+ *
+ *		   Note:  Must be called with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  rate	  irqs per second, 0 = hybrid mode off
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void hybridSet /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   rate
+ )
+{
+	llHdl->hybRate	   = rate;
+	llHdl->hybWinTicks = llHdl->tickRate / 10;
+	if( llHdl->hybWinTicks == 0 )
+		llHdl->hybWinTicks = 1;
+	llHdl->hybWinMax   = (rate * llHdl->hybWinTicks) / llHdl->tickRate;
+	if( llHdl->hybWinMax == 0 )
+		llHdl->hybWinMax = 1;
+	llHdl->hybWinIrqs  = 0;
+
+	if( !rate && llHdl->pollActive == M22_POLL_HYBRID )
+		{
+			OSS_AlarmClear( llHdl->osHdl, llHdl->pollAlarmHdl );
+			pollStop( llHdl );
+		}/*if*/
+}/*hybridSet*/
+
+/*****************************	hybridCheck  ********************************
+ *
+ *	Description:  Counts the irqs of the current window and switches to
+ *                polling when the irq rate exceeds the hybrid threshold.
+ *
+ *		   Note:  Called from interrupt.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void hybridCheck /*nodoc*/
+(
+ LL_HANDLE *llHdl
+ )
+{
+	u_int32 tick = OSS_TickGet( llHdl->osHdl );
+
+	if( tick - llHdl->hybWinStart >= llHdl->hybWinTicks )
+		{
+			llHdl->hybWinStart = tick;
+			llHdl->hybWinIrqs  = 0;
+		}/*if*/
+
+	if( ++llHdl->hybWinIrqs > llHdl->hybWinMax &&
+		llHdl->pollActive == M22_POLL_OFF )
+		{
+			IDBGWRT_2( ( DBH,">>> M22 hybridCheck: irq storm - polling\n" ) );
+			llHdl->hybCount++;
+			pollStart( llHdl, M22_POLL_HYBRID );
+		}/*if*/
+}/*hybridCheck*/
+
+/*****************************	pollStart  **********************************
+ *
+ *	Description:  Disables the edge irqs of all channels and starts
+ *                polling the edges with the polling timer.
+ *                Edges still latched from INTREG mode are already
+ *                reported, they are flushed like on the switch to
+ *                scan mode.
+ *
+ *		   Note:  Called from interrupt or with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  state	  M22_POLL_xxx
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void pollStart /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   state
+ )
+{
+	u_int32	realMsec;
+	int32	ch;
+
+	if( llHdl->irqMode != M22_24_IRQ_MODE_SCAN )
+		scanFlush( llHdl );
+
+	llHdl->pollActive = state;
+	llHdl->hybQuiet	  = 0;
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		configureIrqForChannel( llHdl, ch, llHdl->irqEnabled );
+
+	OSS_AlarmSet( llHdl->osHdl, llHdl->pollAlarmHdl, llHdl->pollPeriod, 0, &realMsec );
+}/*pollStart*/
+
+/*****************************	pollStop  ***********************************
+ *
+ *	Description:  Enables the edge irqs again and collects the edges
+ *                occurred since the last poll.
+ *                The polling timer must be stopped by the caller
+ *                (or not be rearmed).
+ *
+ *		   Note:  Called from timer or with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void pollStop /*nodoc*/
+(
+ LL_HANDLE *llHdl
+ )
+{
+	int32	ch, nbrOfEdges;
+
+	llHdl->pollActive  = M22_POLL_OFF;
+	llHdl->hybWinIrqs  = 0;
+	llHdl->hybWinStart = OSS_TickGet( llHdl->osHdl );
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		configureIrqForChannel( llHdl, ch, llHdl->irqEnabled );
+
+	/* edges between last poll and irq enable */
+	nbrOfEdges = scanEdges( llHdl );
+	if( nbrOfEdges )
+		notifyEdges( llHdl, nbrOfEdges );
+}/*pollStop*/
+
+/*****************************	pollAlarm  **********************************
+ *
+ *	Description:  Polling timer function.
+ *                Collects the edges of all active channels and reports
+ *                them like M22_Irq() does. In polling mode INTREG is read
+ *                to reset the module irq. In hybrid mode the irqs are
+ *                enabled again after M22_HYB_QUIET polls with an edge
+ *                rate below half of the hybrid threshold.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  arg	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void pollAlarm /*nodoc*/
+(
+ void *arg
+ )
+{
+	LL_HANDLE		*llHdl = (LL_HANDLE*)arg;
+	OSS_IRQ_STATE	irqState;
+	u_int32			hits, realMsec;
+	int32			nbrOfEdges;
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	if( llHdl->pollActive == M22_POLL_OFF )
+		goto CLEANUP;
+
+	/* reset a pending (not routed) irq */
+	if( llHdl->pollActive == M22_POLL_ALWAYS )
+		MREAD_D16( llHdl->ma, INTREG );
+
+	hits = llHdl->scanHits;
+	nbrOfEdges = scanEdges( llHdl );
+	hits = llHdl->scanHits - hits;
+	if( nbrOfEdges )
+		notifyEdges( llHdl, nbrOfEdges );
+
+	if( llHdl->pollActive == M22_POLL_HYBRID )
+		{
+			/* registers with edges ~ irqs without polling */
+			if( hits * 1000 < (llHdl->hybRate / 2) * llHdl->pollPeriod )
+				{
+					if( ++llHdl->hybQuiet >= M22_HYB_QUIET )
+						{
+							IDBGWRT_2( ( DBH,">>> M22 pollAlarm: quiet - irq\n" ) );
+							pollStop( llHdl );
+							goto CLEANUP;
+						}/*if*/
+				}
+			else
+				llHdl->hybQuiet = 0;
+		}/*if*/
+
+	OSS_AlarmSet( llHdl->osHdl, llHdl->pollAlarmHdl, llHdl->pollPeriod, 0, &realMsec );
+
+ CLEANUP:
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*pollAlarm*/
+
+/*****************************	pollModeSet  ********************************
+ *
+ *	Description:  Switches between interrupt and polling mode.
+ *                In polling mode the edge irqs are never enabled, the
+ *                edges are collected every pollPeriod ms.
+ *
+ *		   Note:  Must be called with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  mode	  M22_24_POLL_MODE_xxx
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void pollModeSet /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   mode
+ )
+{
+	if( mode == M22_24_POLL_MODE_POLL )
+		{
+			if( llHdl->pollActive == M22_POLL_OFF )
+				pollStart( llHdl, M22_POLL_ALWAYS );
+			else
+				llHdl->pollActive = M22_POLL_ALWAYS;	/* hybrid timer keeps running */
+		}
+	else if( llHdl->pollActive == M22_POLL_ALWAYS )
+		{
+			OSS_AlarmClear( llHdl->osHdl, llHdl->pollAlarmHdl );
+			pollStop( llHdl );
+		}/*if*/
+}/*pollModeSet*/
+
+/*****************************	portRead  ***********************************
+ *
+ *	Description:  Reads the inputs, output switches and alarms of all
+ *                channels as bit masks (bit n = channel n).
+ *                Debounced channels report the debounced input level.
+ *                Outputs and alarms are 0 for the M24.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  portP	  result
+ *
+ *	Output.....:  *portP  result
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void portRead /*nodoc*/
+(
+ LL_HANDLE	 *llHdl,
+ M22_24_PORT *portP
+ )
+{
+	u_int8	ch, reg;
+
+	portP->inputs	= 0;
+	portP->outputs	= 0;
+	portP->alarms	= 0;
+
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		{
+			reg = ioRead( llHdl, ch );
+
+			if( llHdl->debActive[ch] ? llHdl->debLevel[ch] : (reg & IOREG_INPUT_OR_ALARM_VAL) )
+				portP->inputs |= (u_int16)(1 << ch);
+
+			if( llHdl->modId != M22_MOD_ID )
+				continue;
+
+			if( reg & IOREG_OUTPUT_SWITCH )
+				portP->outputs |= (u_int8)(1 << ch);
+			if( MREAD_D16( llHdl->ma, ALARMREG(ch) ) & IOREG_INPUT_OR_ALARM_VAL )
+				portP->alarms |= (u_int8)(1 << ch);
+		}/*for*/
+}/*portRead*/
+
+/*****************************	portWrite  **********************************
+ *
+ *	Description:  Sets the output switches of all active M22 channels
+ *                from a bit mask (bit n = channel n).
+ *                Only channels whose output changes are written.
+ *                Bits of inactive channels are ignored.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  mask	  output switches, 1 = on
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void portWrite /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   mask
+ )
+{
+	OSS_IRQ_STATE	irqState;
+	u_int8			ch;
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		{
+			if( llHdl->activeCh[ch] &&
+				((mask >> ch) & 1) != (u_int32)(llHdl->ioShadow[ch] & IOREG_OUTPUT_SWITCH) )
+				outputSet( llHdl, ch, (u_int8)((mask >> ch) & 1) );
+		}/*for*/
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*portWrite*/
+
+/*****************************	portModify  *********************************
+ *
+ *	Description:  Clears, sets and toggles the output switches of the
+ *                active M22 channels in one pass with irq masked:
+ *                  new = ((old & ~clear) | set) ^ toggle
+ *                Only channels whose output changes are written.
+ *                Bits of inactive channels are ignored.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  masks	  set (bit 7..0), clear (bit 15..8) and
+ *                        toggle (bit 23..16) mask, see M22_OUT_MODIFY()
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void portModify /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   masks
+ )
+{
+	OSS_IRQ_STATE	irqState;
+	u_int8			ch, on, set, clr, tgl;
+
+	set = (u_int8)masks;
+	clr = (u_int8)(masks >> 8);
+	tgl = (u_int8)(masks >> 16);
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		{
+			if( !llHdl->activeCh[ch] )
+				continue;
+
+			on = (u_int8)(llHdl->ioShadow[ch] & IOREG_OUTPUT_SWITCH);
+			if( clr & (1 << ch) )
+				on = 0;
+			if( set & (1 << ch) )
+				on = 1;
+			if( tgl & (1 << ch) )
+				on = (u_int8)!on;
+
+			if( on != (llHdl->ioShadow[ch] & IOREG_OUTPUT_SWITCH) )
+				outputSet( llHdl, ch, on );
+		}/*for*/
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*portModify*/
+
+/*****************************	msToTicks  **********************************
+ *
+ *	Description:  Converts milliseconds to OSS ticks (rounded down)
+ *                without overflow of the intermediate product.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  msec	  time [ms]
+ *
+ *	Output.....:  return  time [ticks]
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static u_int32 msToTicks /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   msec
+ )
+{
+	return( (msec / 1000) * llHdl->tickRate
+			+ ((msec % 1000) * llHdl->tickRate) / 1000 );
+}/*msToTicks*/
+
+/*****************************	msToTicksRound  *****************************
+ *
+ *	Description:  Converts milliseconds to OSS ticks (rounded to nearest)
+ *                without overflow of the intermediate product.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  msec	  time [ms]
+ *
+ *	Output.....:  return  time [ticks]
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static u_int32 msToTicksRound /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   msec
+ )
+{
+	return( (msec / 1000) * llHdl->tickRate
+			+ ((msec % 1000) * llHdl->tickRate + 500) / 1000 );
+}/*msToTicksRound*/
+
+/*****************************	ticksToMs  **********************************
+ *
+ *	Description:  Converts OSS ticks to milliseconds (rounded up)
+ *                without overflow of the intermediate product.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ticks	  time [ticks]
+ *
+ *	Output.....:  return  time [ms]
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static u_int32 ticksToMs /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   ticks
+ )
+{
+	return( (ticks / llHdl->tickRate) * 1000
+			+ ((ticks % llHdl->tickRate) * 1000 + llHdl->tickRate - 1) / llHdl->tickRate );
+}/*ticksToMs*/
+
+/*****************************	seqSet  *************************************
+ *
+ *	Description:  Loads and starts the output sequence.
+ *                A running sequence is stopped first. The step times
+ *                must not decrease and must be below the loop period
+ *                when looping. A loop period must be one tick at least.
+ *                The first step is output immediately if its time is 0.
+ *                The times are kept in ms and converted per loop, so the
+ *                loop starts don't drift by the tick rounding.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  seqP	  sequence header followed by the steps
+ *				  size	  size of *seqP incl. steps
+ *
+ *	Output.....:  return  0 | error code
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static int32 seqSet /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ M22_SEQ   *seqP,
+ int32	   size
+ )
+{
+	DBGCMD(	static const char functionName[] = "LL - seqSet:"; )
+	OSS_IRQ_STATE	irqState;
+	M22_SEQ_STEP	*stepP = (M22_SEQ_STEP*)(seqP + 1);
+	u_int32			i;
+
+	if( size < (int32)sizeof(M22_SEQ) ||
+		seqP->nbrSteps > M22_SEQ_MAX_STEPS ||
+		size < (int32)(sizeof(M22_SEQ) + seqP->nbrSteps * sizeof(M22_SEQ_STEP)) )
+		return( ERR_LL_USERBUF );
+
+	for( i = 0; i < seqP->nbrSteps; i++ )
+		{
+			if( (i && stepP[i].time < stepP[i-1].time) ||
+				((seqP->flags & M22_SEQ_LOOP) && stepP[i].time >= seqP->period) )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: illegal time of step %d %s%d%s",
+								  errorStartStr, functionName, i,
+								  errorLineStr, __LINE__, errorEndStr ));
+					return( ERR_LL_ILL_PARAM );
+				}/*if*/
+		}/*for*/
+
+	if( (seqP->flags & M22_SEQ_LOOP) && msToTicks( llHdl, seqP->period ) == 0 )
+		{
+			DBGWRT_ERR(	( DBH, "%s%s: loop period %dms below one tick %s%d%s",
+						  errorStartStr, functionName, seqP->period,
+						  errorLineStr, __LINE__, errorEndStr ));
+			return( ERR_LL_ILL_PARAM );
+		}/*if*/
+
+	seqStop( llHdl );
+
+	/* (re)allocate steps */
+	if( llHdl->seqBuf != NULL &&
+		llHdl->seqGotSize < seqP->nbrSteps * sizeof(M22_STEP) )
+		{
+			OSS_MemFree( llHdl->osHdl, (int8*) llHdl->seqBuf, llHdl->seqGotSize );
+			llHdl->seqBuf = NULL;
+		}/*if*/
+	llHdl->seqNbr = 0;
+	if( !seqP->nbrSteps )
+		return( 0 );
+
+	if( llHdl->seqBuf == NULL )
+		{
+			llHdl->seqBuf = (M22_STEP*) OSS_MemGet( llHdl->osHdl,
+													seqP->nbrSteps * sizeof(M22_STEP),
+													&llHdl->seqGotSize );
+			if( llHdl->seqBuf == NULL )
+				return( ERR_OSS_MEM_ALLOC );
+		}/*if*/
+
+	for( i = 0; i < seqP->nbrSteps; i++ )
+		{
+			llHdl->seqBuf[i].time = stepP[i].time;
+			llHdl->seqBuf[i].mask = stepP[i].mask;
+		}/*for*/
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	llHdl->seqNbr		= seqP->nbrSteps;
+	llHdl->seqFlags		= seqP->flags;
+	llHdl->seqPeriodT	= msToTicks( llHdl, seqP->period );
+	llHdl->seqPeriodFrac = ((seqP->period % 1000) * llHdl->tickRate) % 1000;
+	llHdl->seqStart		= OSS_TickGet( llHdl->osHdl );
+	llHdl->seqFrac		= 0;
+	llHdl->seqIdx		= 0;
+	llHdl->seqLoops		= 0;
+	llHdl->seqUnderruns = 0;
+	llHdl->seqState		= M22_SEQ_RUNNING;
+	seqRun( llHdl );
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+	return( 0 );
+}/*seqSet*/
+
+/*****************************	seqStop  ************************************
+ *
+ *	Description:  Stops the output sequence. The outputs keep their state.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void seqStop /*nodoc*/
+(
+ LL_HANDLE *llHdl
+ )
+{
+	OSS_IRQ_STATE	irqState;
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	if( llHdl->seqState == M22_SEQ_RUNNING )
+		{
+			OSS_AlarmClear( llHdl->osHdl, llHdl->seqAlarmHdl );
+			llHdl->seqState = M22_SEQ_IDLE;
+		}/*if*/
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*seqStop*/
+
+/*****************************	seqDue  *************************************
+ *
+ *	Description:  Gets the tick a step of the current loop is due,
+ *                rounded to the nearest tick.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  msec	  step time, offset from loop start [ms]
+ *
+ *	Output.....:  return  due tick
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static u_int32 seqDue /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   msec
+ )
+{
+	return( llHdl->seqStart + (msec / 1000) * llHdl->tickRate
+			+ ((msec % 1000) * llHdl->tickRate + llHdl->seqFrac + 500) / 1000 );
+}/*seqDue*/
+
+/*****************************	seqLoopAdd  *********************************
+ *
+ *	Description:  Advances the loop start by a number of loop periods.
+ *                The fraction of a tick is carried, so the loop start
+ *                stays exact for any period and tick rate.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  nbr	  number of loops
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void seqLoopAdd /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int32   nbr
+ )
+{
+	u_int32 frac = (nbr % 1000) * llHdl->seqPeriodFrac + llHdl->seqFrac;
+
+	llHdl->seqStart += nbr * llHdl->seqPeriodT
+		+ (nbr / 1000) * llHdl->seqPeriodFrac + frac / 1000;
+	llHdl->seqFrac	 = frac % 1000;
+}/*seqLoopAdd*/
+
+/*****************************	seqRun  *************************************
+ *
+ *	Description:  Outputs all due steps of the sequence and starts the
+ *                timer for the next one.
+ *                A step output after its due tick was late and is
+ *                counted as underrun. Steps rounded to the same tick are
+ *                output together without underrun. Whole loop periods
+ *                missed are skipped and their steps counted as underruns.
+ *
+ *		   Note:  Must be called with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void seqRun /*nodoc*/
+(
+ LL_HANDLE *llHdl
+ )
+{
+	u_int32	now, due, skip, realMsec, delta = 0;
+
+	if( llHdl->seqState != M22_SEQ_RUNNING )
+		return;
+
+	now = OSS_TickGet( llHdl->osHdl );
+
+	for(;;)
+		{
+			if( llHdl->seqIdx == llHdl->seqNbr )
+				{
+					if( !(llHdl->seqFlags & M22_SEQ_LOOP) )
+						{
+							llHdl->seqState = M22_SEQ_DONE;
+							break;
+						}/*if*/
+
+					seqLoopAdd( llHdl, 1 );
+					llHdl->seqLoops++;
+					llHdl->seqIdx = 0;
+
+					/* skip missed periods (a period is below seqPeriodT+1) */
+					if( (int32)(now - llHdl->seqStart) > 0 )
+						{
+							skip = (now - llHdl->seqStart) / (llHdl->seqPeriodT + 1);
+							seqLoopAdd( llHdl, skip );
+							llHdl->seqLoops		+= skip;
+							llHdl->seqUnderruns += skip * llHdl->seqNbr;
+						}/*if*/
+				}/*if*/
+
+			due = seqDue( llHdl, llHdl->seqBuf[llHdl->seqIdx].time );
+			if( (int32)(due - now) > 0 )
+				{
+					delta = due - now;
+					break;
+				}/*if*/
+
+			if( due != now )
+				llHdl->seqUnderruns++;
+
+			portWrite( llHdl, llHdl->seqBuf[llHdl->seqIdx].mask );
+			llHdl->seqIdx++;
+		}/*for*/
+
+	if( llHdl->seqState == M22_SEQ_RUNNING )
+		OSS_AlarmSet( llHdl->osHdl, llHdl->seqAlarmHdl,
+					  ticksToMs( llHdl, delta ), 0, &realMsec );
+}/*seqRun*/
+
+/*****************************	seqAlarm  ***********************************
+ *
+ *	Description:  Output sequencer timer function.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  arg	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void seqAlarm /*nodoc*/
+(
+ void *arg
+ )
+{
+	LL_HANDLE		*llHdl = (LL_HANDLE*)arg;
+	OSS_IRQ_STATE	irqState;
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	seqRun( llHdl );
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*seqAlarm*/
+
+/*****************************	seqStatusGet  *******************************
+ *
+ *	Description:  Gets the progress of the output sequence.
+ *
+ *		   Note:  Must be called with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  statP	  pointer to status
+ *
+ *	Output.....:  *statP  status
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void seqStatusGet /*nodoc*/
+(
+ LL_HANDLE		*llHdl,
+ M22_SEQ_STATUS *statP
+ )
+{
+	statP->state	 = llHdl->seqState;
+	statP->step		 = llHdl->seqIdx;
+	statP->nbrSteps	 = llHdl->seqNbr;
+	statP->loops	 = llHdl->seqLoops;
+	statP->underruns = llHdl->seqUnderruns;
+}/*seqStatusGet*/
+
+/*****************************	pwmSet  *************************************
+ *
+ *	Description:  Sets period and duty cycle of the software PWM of an
+ *                M22 output and (re)starts it with a new period.
+ *                Period 0 stops the PWM and switches the output off.
+ *                Period and on time are rounded to the nearest OSS tick,
+ *                so the period must be M22_PWM_MIN_TICKS at least to keep
+ *                the duty cycle error below 5%.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ch	  channel 0..7
+ *				  period  period [ms], 0 = off
+ *				  duty	  duty cycle [1/1000]
+ *
+ *	Output.....:  return  0 | error code
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static int32 pwmSet /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int8	   ch,
+ u_int32   period,
+ u_int32   duty
+ )
+{
+	DBGCMD(	static const char functionName[] = "LL - pwmSet:"; )
+	OSS_IRQ_STATE	irqState;
+	u_int32			ticks;
+
+	ticks = msToTicksRound( llHdl, period );
+	if( period && ticks < M22_PWM_MIN_TICKS )
+		{
+			DBGWRT_ERR(	( DBH, "%s%s: period %dms below %d ticks %s%d%s",
+						  errorStartStr, functionName, period, M22_PWM_MIN_TICKS,
+						  errorLineStr, __LINE__, errorEndStr ));
+			return( ERR_LL_ILL_PARAM );
+		}/*if*/
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+
+	llHdl->pwmPeriod[ch]  = period;
+	llHdl->pwmDuty[ch]	  = duty;
+	llHdl->pwmPeriodT[ch] = ticks;
+	llHdl->pwmOnT[ch]	  = (ticks / 1000) * duty + ((ticks % 1000) * duty + 500) / 1000;
+	llHdl->pwmStart[ch]	  = OSS_TickGet( llHdl->osHdl );
+
+	if( !ticks )
+		outputSet( llHdl, ch, 0 );
+
+	/* restart timer with new schedule */
+	if( llHdl->pwmAlarmActive )
+		{
+			OSS_AlarmClear( llHdl->osHdl, llHdl->pwmAlarmHdl );
+			llHdl->pwmAlarmActive = 0;
+		}/*if*/
+	pwmRun( llHdl );
+
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+	return( 0 );
+}/*pwmSet*/
+
+/*****************************	pwmStop  ************************************
+ *
+ *	Description:  Stops the software PWM of all channels.
+ *                The outputs keep their state.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void pwmStop /*nodoc*/
+(
+ LL_HANDLE *llHdl
+ )
+{
+	OSS_IRQ_STATE	irqState;
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	OSS_MemFill( llHdl->osHdl, sizeof(llHdl->pwmPeriodT), (char*)llHdl->pwmPeriodT, 0 );
+	if( llHdl->pwmAlarmActive )
+		{
+			OSS_AlarmClear( llHdl->osHdl, llHdl->pwmAlarmHdl );
+			llHdl->pwmAlarmActive = 0;
+		}/*if*/
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*pwmStop*/
+
+/*****************************	pwmRun  *************************************
+ *
+ *	Description:  Switches the PWM outputs according to their position in
+ *                the current period and starts the timer for the next
+ *                switching time of all channels.
+ *                Missed periods are skipped, so late timers don't shift
+ *                the phase.
+ *
+ *		   Note:  Must be called with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void pwmRun /*nodoc*/
+(
+ LL_HANDLE *llHdl
+ )
+{
+	u_int32	tick, elapsed, due, next = 0, realMsec;
+	u_int8	ch, on;
+
+	tick = OSS_TickGet( llHdl->osHdl );
+
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		{
+			if( !llHdl->pwmPeriodT[ch] )
+				continue;
+
+			elapsed = tick - llHdl->pwmStart[ch];
+			if( elapsed >= llHdl->pwmPeriodT[ch] )
+				{
+					llHdl->pwmStart[ch] += elapsed - (elapsed % llHdl->pwmPeriodT[ch]);
+					elapsed %= llHdl->pwmPeriodT[ch];
+				}/*if*/
+
+			on = (u_int8)(elapsed < llHdl->pwmOnT[ch]);
+			if( on != (llHdl->ioShadow[ch] & IOREG_OUTPUT_SWITCH) )
+				outputSet( llHdl, ch, on );
+
+			/* 0% and 100% don't switch within the period */
+			due = on ? llHdl->pwmOnT[ch] - elapsed : llHdl->pwmPeriodT[ch] - elapsed;
+			if( !next || due < next )
+				next = due;
+		}/*for*/
+
+	if( next )
+		{
+			llHdl->pwmAlarmActive = 1;
+			OSS_AlarmSet( llHdl->osHdl, llHdl->pwmAlarmHdl,
+						  ticksToMs( llHdl, next ), 0, &realMsec );
+		}/*if*/
+}/*pwmRun*/
+
+/*****************************	pwmAlarm  ***********************************
+ *
+ *	Description:  Software PWM timer function.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  arg	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void pwmAlarm /*nodoc*/
+(
+ void *arg
+ )
+{
+	LL_HANDLE		*llHdl = (LL_HANDLE*)arg;
+	OSS_IRQ_STATE	irqState;
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	llHdl->pwmAlarmActive = 0;
+	pwmRun( llHdl );
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*pwmAlarm*/
+
+/*****************************	pulseStart  *********************************
+ *
+ *	Description:  Switches an M22 output on and starts the timer to
+ *                switch it off after the given time. A running pulse of
+ *                the channel is retriggered, time 0 ends it now.
+ *                The pulse time is rounded up to n OSS ticks. The pulse
+ *                starts anywhere within the current tick, so one tick is
+ *                added and the pulse lasts n..n+1 ticks plus the timer
+ *                latency, never less than requested. Pulses shorter
+ *                than one tick are rejected.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  ch	  channel 0..7
+ *				  us	  pulse time [us]
+ *
+ *	Output.....:  return  0 | error code
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static int32 pulseStart /*nodoc*/
+(
+ LL_HANDLE *llHdl,
+ u_int8	   ch,
+ u_int32   us
+ )
+{
+	DBGCMD(	static const char functionName[] = "LL - pulseStart:"; )
+	OSS_IRQ_STATE	irqState;
+
+	if( us && us < llHdl->usPerTick )
+		{
+			DBGWRT_ERR(	( DBH, "%s%s: pulse %dus below one tick %s%d%s",
+						  errorStartStr, functionName, us,
+						  errorLineStr, __LINE__, errorEndStr ));
+			return( ERR_LL_ILL_PARAM );
+		}/*if*/
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+
+	llHdl->pulseActive[ch] = 1;
+	llHdl->pulseEnd[ch]	   = OSS_TickGet( llHdl->osHdl );
+	if( us )
+		{
+			outputSet( llHdl, ch, 1 );
+			llHdl->pulseEnd[ch] += (us / llHdl->usPerTick)
+				+ ((us % llHdl->usPerTick) ? 1 : 0) + 1;
+		}/*if*/
+
+	/* restart timer with new schedule */
+	if( llHdl->pulseAlarmActive )
+		{
+			OSS_AlarmClear( llHdl->osHdl, llHdl->pulseAlarmHdl );
+			llHdl->pulseAlarmActive = 0;
+		}/*if*/
+	pulseRun( llHdl );
+
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+	return( 0 );
+}/*pulseStart*/
+
+/*****************************	pulseStop  **********************************
+ *
+ *	Description:  Stops the pulse timer. The outputs keep their state.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void pulseStop /*nodoc*/
+(
+ LL_HANDLE *llHdl
+ )
+{
+	OSS_IRQ_STATE	irqState;
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	OSS_MemFill( llHdl->osHdl, sizeof(llHdl->pulseActive), (char*)llHdl->pulseActive, 0 );
+	if( llHdl->pulseAlarmActive )
+		{
+			OSS_AlarmClear( llHdl->osHdl, llHdl->pulseAlarmHdl );
+			llHdl->pulseAlarmActive = 0;
+		}/*if*/
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*pulseStop*/
+
+/*****************************	pulseRun  ***********************************
+ *
+ *	Description:  Switches off the outputs of expired pulses, sends the
+ *                pulse done signal and starts the timer for the next
+ *                pulse end.
+ *
+ *		   Note:  Must be called with irq masked.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void pulseRun /*nodoc*/
+(
+ LL_HANDLE *llHdl
+ )
+{
+	u_int32	tick, due, next = 0, realMsec;
+	u_int8	ch, done = 0;
+
+	tick = OSS_TickGet( llHdl->osHdl );
+
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		{
+			if( !llHdl->pulseActive[ch] )
+				continue;
+
+			if( (int32)(tick - llHdl->pulseEnd[ch]) >= 0 )
+				{
+					outputSet( llHdl, ch, 0 );
+					llHdl->pulseActive[ch] = 0;
+					done++;
+					continue;
+				}/*if*/
+
+			due = llHdl->pulseEnd[ch] - tick;
+			if( !next || due < next )
+				next = due;
+		}/*for*/
+
+	if( next )
+		{
+			llHdl->pulseAlarmActive = 1;
+			OSS_AlarmSet( llHdl->osHdl, llHdl->pulseAlarmHdl,
+						  ticksToMs( llHdl, next ), 0, &realMsec );
+		}/*if*/
+
+	if( done && llHdl->pulseSigHdl != NULL )
+		if( OSS_SigSend( llHdl->osHdl, llHdl->pulseSigHdl ) )
+			llHdl->sigSendErr++;
+}/*pulseRun*/
+
+/*****************************	pulseAlarm  *********************************
+ *
+ *	Description:  One-shot pulse timer function.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  arg	  pointer to low-level driver data structure
+ *
+ *	Output.....:  -
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static void pulseAlarm /*nodoc*/
+(
+ void *arg
+ )
+{
+	LL_HANDLE		*llHdl = (LL_HANDLE*)arg;
+	OSS_IRQ_STATE	irqState;
+
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	llHdl->pulseAlarmActive = 0;
+	pulseRun( llHdl );
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+}/*pulseAlarm*/
+
+/*****************************	configSet  **********************************
+ *
+ *	Description:  Applies a list of setstats (vectored configuration).
+ *                The irq configuration of the touched channels is done
+ *                once at the end, with irq masked only once.
+ *                All entries are applied, failing entries don't stop
+ *                the transaction. The error of each entry is kept for
+ *                M22_24_GETBLOCK_CONFIG_ERR.
+ *
+ *---------------------------------------------------------------------------
+ *	Input......:  llHdl	  pointer to low-level driver data structure
+ *				  cfgP	  entries
+ *				  nbr	  number of entries
+ *
+ *	Output.....:  return  0 | error code of first failed entry
+ *
+ *	Globals....:  -
+ ****************************************************************************/
+static int32 configSet /*nodoc*/
+(
+ LL_HANDLE	   *llHdl,
+ M22_24_CONFIG *cfgP,
+ int32		   nbr
+ )
+{
+	DBGCMD(	static const char functionName[] = "LL - configSet:"; )
+	OSS_IRQ_STATE	irqState;
+	int32			i, ch, error = 0;
+
+	llHdl->cfgDefer = 1;
+	llHdl->cfgDirty = 0;
+	llHdl->cfgNbr	= nbr;
+
+	for( i = 0; i < nbr; i++, cfgP++ )
+		{
+			/* no block codes, value is no pointer here */
+			if( cfgP->ch < 0 || cfgP->ch >= (int32)llHdl->nbrOfChannels ||
+				(M_LL_BLK_OF <= cfgP->code && cfgP->code <= (M_LL_BLK_OF+0xff)) ||
+				(M_DEV_BLK_OF <= cfgP->code && cfgP->code <= (M_DEV_BLK_OF+0xff)) )
+				llHdl->cfgErr[i] = ERR_LL_ILL_PARAM;
+			else
+				llHdl->cfgErr[i] = M22_SetStat( llHdl, cfgP->code, cfgP->ch,
+												(INT32_OR_64)cfgP->value );
+
+			if( llHdl->cfgErr[i] )
+				{
+					DBGWRT_ERR( ( DBH, "%s%s: entry %d code=0x%x failed %s%d%s",
+								  errorStartStr, functionName, i, cfgP->code,
+								  errorLineStr, __LINE__, errorEndStr ));
+					if( !error )
+						error = llHdl->cfgErr[i];
+				}/*if*/
+		}/*for*/
 
-	if( value && llHdl->activeCh[ch] )
-		{
-			/* enable active channels */
-			MSETMASK_D16( llHdl->ma, IOREG(ch), llHdl->inputEdgeMask[ch] );
-			if( llHdl->modId == M22_MOD_ID )
-				MSETMASK_D16( llHdl->ma, ALARMREG(ch), llHdl->alarmEdgeMask[ch]  );
-		}/*if*/
-}/*configureIrqForChannel*/
+	/* reconfigure the touched channels at once */
+	llHdl->cfgDefer = 0;
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	for( ch = 0; ch < (int32)llHdl->nbrOfChannels; ch++ )
+		if( llHdl->cfgDirty & (1 << ch) )
+			configureIrqForChannel( llHdl, ch, llHdl->irqEnabled );
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+	return( error );
+}/*configSet*/
 
 
 /**************************** M22_GetEntry *********************************
@@ -311,6 +3044,38 @@ void M22_GetEntry( LL_ENTRY* drvP )  /*nodoc*/
  *	DEBUG_LEVEL_DESC              OSS_DBG_DEFAULT    see oss_os.h
  *	DEBUG_LEVEL                   OSS_DBG_DEFAULT    see oss_os.h
  *
+ *	EVENT_BUF_SIZE                64                 0..0x15555555 number of
+ *                                                        event records
+ *                                                        0 - no event buffer
+ *
+ *	IRQ_MODE                      0                  0..1 0 - INTREG channel only
+ *                                                        1 - scan all channels
+ *
+ *	SIG_HOLDOFF                   0                  0..n signal holdoff time [ms]
+ *                                                        0 - no holdoff
+ *
+ *	SIG_THRESHOLD                 0                  0..n edges per signal
+ *                                                        0 - no threshold
+ *                                                        without SIG_HOLDOFF
+ *                                                        100ms holdoff
+ *
+ *	MEAS_GATE                     100                0..n measurement gate [ms]
+ *
+ *	HYBRID_IRQ_RATE               0                  0..n irqs per second to
+ *                                                        switch to polling
+ *                                                        0 - irqs only
+ *
+ *	POLL_MODE                     0                  0..1 0 - interrupts
+ *                                                        1 - polling, no irqs
+ *                                                        (m22_nirq: always 1)
+ *
+ *	POLL_PERIOD                   10                 1..n polling period [ms]
+ *
+ *	CACHED_READ                   0                  0..1 0 - read registers
+ *                                                        1 - read image kept
+ *                                                        by irq if possible
+ *                                                        (IRQ_MODE 1 only)
+ *
  *	CHANNEL_%d/INACTIVE           0                  0..1 0 - active
  *                                                        1 - not active
  *                                                    %d	0..7..15
@@ -327,6 +3092,29 @@ void M22_GetEntry( LL_ENTRY* drvP )  /*nodoc*/
  *                                                        3	- any edge
  *                                                    %d	0..7
  *
+ *	CHANNEL_%d/COUNTER_MODE       0                  0..1 0 - events and signals
+ *                                                        1 - count edges only
+ *                                                    %d	0..7..15
+ *
+ *	CHANNEL_%d/MEAS_MODE          0                  0..2 0 - no measurement
+ *                                                        1 - period of rising
+ *                                                        2 - period of falling
+ *                                                            edges
+ *                                                    %d	0..7..15
+ *
+ *	CHANNEL_%d/DEBOUNCE_US        0                  0..n debounce time [us]
+ *                                                        0 - no debounce
+ *                                                    %d	0..7..15
+ *
+ *	CHANNEL_%d/PWM_PERIOD         0                  0..n PWM period [ms]
+ *                                                        0 - no PWM
+ *                                                        min. 10 ticks
+ *                                                    %d	0..7 (M22 only)
+ *
+ *	CHANNEL_%d/PWM_DUTY           500                0..1000 PWM duty cycle
+ *                                                        [1/1000]
+ *                                                    %d	0..7 (M22 only)
+ *
  *  Note:  Is called by MDIS kernel only.
  *---------------------------------------------------------------------------
  *	Input......:  descSpec descriptor specifier
@@ -363,6 +3151,7 @@ static int32 M22_Init
 	u_int32		mask;
 	volatile	u_int16	 intFromCh;
 	u_int32		dbgLevelDesc;
+	u_int32		evBufSize;
 
 
 	retCode	= DESC_Init( descSpec, osHdl, &descHdl );
@@ -389,6 +3178,7 @@ static int32 M22_Init
 	llHdl->osHdl		= osHdl;
 	llHdl->ma			= *ma;
 	llHdl->irqHdl		= irqHdl;
+	llHdl->devSemHdl	= devSem;
 
 	/*------------------------------+
 	  |  init	id function	table		|
@@ -431,6 +3221,158 @@ static int32 M22_Init
 
 	DBGWRT_1((DBH, "%s\n", functionName	)  );
 
+	/*-------------------------------------+
+	  |	event buffer					   |
+	  +-------------------------------------*/
+	retCode	= DESC_GetUInt32( descHdl,
+							  M22_EVENT_BUF_SIZE,
+							  &evBufSize,
+							  "EVENT_BUF_SIZE",
+							  NULL );
+	if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+	retCode	= 0;
+	if( evBufSize > M22_EVENT_BUF_MAX )
+		{
+			retCode = ERR_LL_ILL_PARAM;
+			DBGWRT_ERR( ( DBH,	"%s%s: EVENT_BUF_SIZE out of range %s%d%s",
+						  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+			goto CLEANUP;
+		}/*if*/
+
+	if( evBufSize )
+		{
+			llHdl->evBuf = (M22_24_EVENT*) OSS_MemGet( osHdl,
+													   evBufSize * sizeof(M22_24_EVENT),
+													   &llHdl->evBufGotSize );
+			if( llHdl->evBuf == NULL )
+				{
+					retCode = ERR_OSS_MEM_ALLOC;
+					goto CLEANUP;
+				}/*if*/
+			llHdl->evMax = evBufSize;
+		}/*if*/
+
+	/* IRQ_MODE */
+	retCode	= DESC_GetUInt32( descHdl,
+							  M22_24_IRQ_MODE_INTREG,
+							  &llHdl->irqMode,
+							  "IRQ_MODE",
+							  NULL );
+	if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+	retCode	= 0;
+	if( llHdl->irqMode > M22_24_IRQ_MODE_SCAN )
+		{
+			retCode = ERR_LL_DESC_PARAM;
+			DBGWRT_ERR( ( DBH,	"%s%s: IRQ_MODE out of range %s%d%s",
+						  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+			goto CLEANUP;
+		}/*if*/
+
+	/*-------------------------------------+
+	  |	signal coalescing				   |
+	  +-------------------------------------*/
+	retCode	= DESC_GetUInt32( descHdl,
+							  0,
+							  &llHdl->sigHoldoff,
+							  "SIG_HOLDOFF",
+							  NULL );
+	if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+
+	retCode	= DESC_GetUInt32( descHdl,
+							  0,
+							  &llHdl->sigThreshold,
+							  "SIG_THRESHOLD",
+							  NULL );
+	if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+
+	retCode = OSS_AlarmCreate( osHdl, sigAlarm, llHdl, &llHdl->sigAlarmHdl );
+	if( retCode ) goto CLEANUP;
+
+	retCode = OSS_AlarmCreate( osHdl, debAlarm, llHdl, &llHdl->debAlarmHdl );
+	if( retCode ) goto CLEANUP;
+
+	retCode = OSS_AlarmCreate( osHdl, pollAlarm, llHdl, &llHdl->pollAlarmHdl );
+	if( retCode ) goto CLEANUP;
+
+	retCode = OSS_AlarmCreate( osHdl, seqAlarm, llHdl, &llHdl->seqAlarmHdl );
+	if( retCode ) goto CLEANUP;
+
+	retCode = OSS_AlarmCreate( osHdl, pwmAlarm, llHdl, &llHdl->pwmAlarmHdl );
+	if( retCode ) goto CLEANUP;
+
+	retCode = OSS_AlarmCreate( osHdl, pulseAlarm, llHdl, &llHdl->pulseAlarmHdl );
+	if( retCode ) goto CLEANUP;
+
+	/* wait for event */
+	retCode = OSS_SemCreate( osHdl, OSS_SEM_BIN, 0, &llHdl->waitSemHdl );
+	if( retCode ) goto CLEANUP;
+
+	/*-------------------------------------+
+	  |	frequency/period measurement	   |
+	  +-------------------------------------*/
+	llHdl->tickRate	 = OSS_TickRateGet( osHdl );
+	llHdl->usPerTick = 1000000 / llHdl->tickRate;
+
+	retCode	= DESC_GetUInt32( descHdl,
+							  M22_MEAS_GATE,
+							  &llHdl->measGate,
+							  "MEAS_GATE",
+							  NULL );
+	if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+	retCode	= 0;
+	measGateSet( llHdl, llHdl->measGate );
+
+	/*-------------------------------------+
+	  |	polling / hybrid mode			   |
+	  +-------------------------------------*/
+	retCode	= DESC_GetUInt32( descHdl,
+							  M22_POLL_PERIOD,
+							  &llHdl->pollPeriod,
+							  "POLL_PERIOD",
+							  NULL );
+	if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+	retCode	= 0;
+	if( llHdl->pollPeriod == 0 )
+		{
+			retCode = ERR_LL_DESC_PARAM;
+			DBGWRT_ERR( ( DBH,	"%s%s: POLL_PERIOD out of range %s%d%s",
+						  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+			goto CLEANUP;
+		}/*if*/
+
+	retCode	= DESC_GetUInt32( descHdl,
+							  M22_USE_IRQ ? M22_24_POLL_MODE_IRQ : M22_24_POLL_MODE_POLL,
+							  &llHdl->pollMode,
+							  "POLL_MODE",
+							  NULL );
+	if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+	retCode	= 0;
+	if( llHdl->pollMode > M22_24_POLL_MODE_POLL ||
+		(!M22_USE_IRQ && llHdl->pollMode != M22_24_POLL_MODE_POLL) )
+		{
+			retCode = ERR_LL_DESC_PARAM;
+			DBGWRT_ERR( ( DBH,	"%s%s: POLL_MODE out of range %s%d%s",
+						  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+			goto CLEANUP;
+		}/*if*/
+
+	retCode	= DESC_GetUInt32( descHdl,
+							  0,
+							  &mask,
+							  "HYBRID_IRQ_RATE",
+							  NULL );
+	if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+	retCode	= 0;
+	hybridSet( llHdl, mask );
+
+	retCode	= DESC_GetUInt32( descHdl,
+							  0,
+							  &llHdl->cachedRead,
+							  "CACHED_READ",
+							  NULL );
+	if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+	retCode	= 0;
+
 	/*---------------------------------+
 	  |  detect M-Module type M22 | M24  |
 	  +---------------------------------*/
@@ -524,6 +3466,78 @@ static int32 M22_Init
 			if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
 			retCode	= 0;
 			llHdl->activeCh[ch] = (u_int8) (mask ? 0 : 1);
+
+			/* counter mode */
+			retCode	= DESC_GetUInt32( descHdl,
+									  0,
+									  &mask,
+									  "CHANNEL_%d/COUNTER_MODE",
+									  ch );
+			if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+			retCode	= 0;
+			llHdl->counterMode[ch] = (u_int8) (mask ? 1 : 0);
+
+			/* measurement mode */
+			retCode	= DESC_GetUInt32( descHdl,
+									  M22_24_MEAS_OFF,
+									  &mask,
+									  "CHANNEL_%d/MEAS_MODE",
+									  ch );
+			if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+			retCode	= 0;
+			if( mask > M22_24_MEAS_FALLING )
+				{
+					retCode = ERR_LL_DESC_PARAM;
+					DBGWRT_ERR( ( DBH,	"%s%s: CHANNEL_%d/MEAS_MODE out of range %s%d%s",
+								  errorStartStr, functionName, ch, errorLineStr, __LINE__, errorEndStr ));
+					goto CLEANUP;
+				}/*if*/
+			llHdl->measMode[ch] = (u_int8) mask;
+
+			/* debounce time */
+			retCode	= DESC_GetUInt32( descHdl,
+									  0,
+									  &mask,
+									  "CHANNEL_%d/DEBOUNCE_US",
+									  ch );
+			if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+			retCode	= 0;
+			debounceSet( llHdl, ch, mask );
+
+			if( llHdl->modId != M22_MOD_ID )
+				continue;
+
+			/* software PWM */
+			retCode	= DESC_GetUInt32( descHdl,
+									  0,
+									  &llHdl->pwmPeriod[ch],
+									  "CHANNEL_%d/PWM_PERIOD",
+									  ch );
+			if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+
+			retCode	= DESC_GetUInt32( descHdl,
+									  M22_PWM_DUTY_DEF,
+									  &llHdl->pwmDuty[ch],
+									  "CHANNEL_%d/PWM_DUTY",
+									  ch );
+			if(	retCode	!= 0 &&	retCode	!= ERR_DESC_KEY_NOTFOUND ) goto	CLEANUP;
+			retCode	= 0;
+			if( llHdl->pwmDuty[ch] > 1000 )
+				{
+					retCode = ERR_LL_DESC_PARAM;
+					DBGWRT_ERR( ( DBH,	"%s%s: CHANNEL_%d/PWM_DUTY out of range %s%d%s",
+								  errorStartStr, functionName, ch, errorLineStr, __LINE__, errorEndStr ));
+					goto CLEANUP;
+				}/*if*/
+			if( llHdl->pwmPeriod[ch] &&
+				msToTicksRound( llHdl, llHdl->pwmPeriod[ch] ) < M22_PWM_MIN_TICKS )
+				{
+					retCode = ERR_LL_DESC_PARAM;
+					DBGWRT_ERR( ( DBH,	"%s%s: CHANNEL_%d/PWM_PERIOD below %d ticks %s%d%s",
+								  errorStartStr, functionName, ch, M22_PWM_MIN_TICKS,
+								  errorLineStr, __LINE__, errorEndStr ));
+					goto CLEANUP;
+				}/*if*/
 		}/*for*/
 
 	/* dummy access	to clear interrupt */
@@ -531,6 +3545,15 @@ static int32 M22_Init
 
 	llHdl->irqSource =	0;				/* reset irqSource flag	*/
 
+	/* start polling */
+	if( llHdl->pollMode == M22_24_POLL_MODE_POLL )
+		pollModeSet( llHdl, llHdl->pollMode );
+
+	/* start PWM */
+	for( ch = 0; ch < llHdl->nbrOfChannels; ch++ )
+		if( llHdl->pwmPeriod[ch] && llHdl->activeCh[ch] )
+			pwmSet( llHdl, ch, llHdl->pwmPeriod[ch], llHdl->pwmDuty[ch] );
+
 	DESC_Exit( &descHdl	);
 	return(	retCode	);
 
@@ -574,6 +3597,11 @@ static int32 M22_Exit
 
 	DBGWRT_1((DBH, "%s\n", functionName) );
 
+	/* stop output timers */
+	seqStop( llHdl );
+	pwmStop( llHdl );
+	pulseStop( llHdl );
+
 	/*--------------------------+
 	  | output off / disable irq	|
 	  +--------------------------*/
@@ -612,6 +3640,11 @@ static int32 M22_Exit
  *               RE:  rising edge occurred
  *               I:   input state
  *               r:   reserved
+ *
+ *  While the debounce window of the channel is open, the debounced
+ *  input state is returned and bounce edges are not reported.
+ *  With M22_24_CACHED_READ the input state may come from the irq
+ *  maintained image (see ioRead()).
  *---------------------------------------------------------------------------
  *	Input......:  llHdl	  pointer to low-level driver data structure
  *				  ch	  current channel 0..7..15
@@ -635,7 +3668,11 @@ static int32 M22_Read
 
 	DBGWRT_1((DBH, "%s\n",	functionName) );
 
-	rdVal  = (u_int8) MREAD_D16( llHdl->ma,	IOREG(ch) );
+	rdVal  = ioRead( llHdl, (u_int8)ch );
+
+	/* debouncing - stable level, ignore bounce edges */
+	if( llHdl->debActive[ch] )
+		rdVal = (u_int8)(llHdl->debLevel[ch] ? IOREG_INPUT_OR_ALARM_VAL : 0);
 
 	/* update state buffer
 	 * - set/reset input bit
@@ -688,6 +3725,7 @@ static int32 M22_Write
 {
 	DBGCMD(	static const char functionName[] = "LL - M22_Write:"; )
 		int32   error = 0;
+	OSS_IRQ_STATE	irqState;
 
 	DBGWRT_1((DBH, "%s ch=%d val=0x%02x\n",	functionName, ch, value) );
 
@@ -699,17 +3737,10 @@ static int32 M22_Write
 			goto CLEANUP;
 		}/*if*/
 
-	/* update state buffer - set output switch */
-	if (value)
-		{
-			llHdl->stateBuf[ch] |= M22_READ_OUTPUT_SWITCH;      /* set output switch bit */
-			MSETMASK_D16(llHdl->ma, IOREG(ch), IOREG_OUTPUT_SWITCH );
-		}
-	else
-		{
-			llHdl->stateBuf[ch] &= ~M22_READ_OUTPUT_SWITCH;      /* reset output switch bit */
-			MCLRMASK_D16(llHdl->ma, IOREG(ch), IOREG_OUTPUT_SWITCH );
-		}/*if*/
+	/* update state buffer and output switch */
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+	outputSet( llHdl, (u_int8)ch, (u_int8)(value ? 1 : 0) );
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
 
  CLEANUP:
 	return( error );
@@ -766,6 +3797,151 @@ static int32 M22_Write
  *
  *  M22_24_CHANNEL_INACTIVE      0..1            0 - activate channel
  *                                               1 - deactivate channel
+ *
+ *  M22_24_EVENT_COUNT           0               discards all buffered events
+ *
+ *  M22_24_EVENT_LOST            0..x            set the lost event counter
+ *
+ *  M22_24_IRQ_MODE              0..1            0 - INTREG channel only
+ *                                               1 - scan all active channels
+ *
+ *  M22_24_SIG_HOLDOFF           0..x            signal holdoff time [ms]
+ *                                               first edge starts the holdoff,
+ *                                               the signal is sent at its end
+ *                                               0 - no holdoff
+ *
+ *  M22_24_SIG_THRESHOLD         0..x            number of edges per signal
+ *                                               fewer edges are signalled
+ *                                               at the end of the holdoff,
+ *                                               100ms if no holdoff is set
+ *                                               0 - no threshold
+ *
+ *  M22_24_SETBLOCK_SIG_SUBSCRIBE                installs a signal for the
+ *                                               calling process, sent only for
+ *                                               matching channels and edges
+ *     blockStruct->size         sizeof(M22_24_SUBSCRIBE)
+ *     blockStruct->data pointer                 M22_24_SUBSCRIBE
+ *                                               sigNo    - signal number
+ *                                               chMask   - bit n = channel n
+ *                                                          0 = all channels
+ *                                               edgeMask - M22_24_SUB_xxx
+ *                                                          0 = all edges
+ *
+ *  M22_24_SIG_UNSUBSCRIBE       signal number   removes the subscription of
+ *                                               the calling process
+ *
+ *  M22_24_SETBLOCK_CONFIG                       applies a list of setstats,
+ *                                               irqs are reconfigured once
+ *                                               at the end
+ *     blockStruct->size         n * sizeof(M22_24_CONFIG), n = 1..64
+ *     blockStruct->data pointer                 M22_24_CONFIG entries
+ *                                               ch    - channel
+ *                                               code  - setstat code (no
+ *                                                       block codes)
+ *                                               value - setstat value
+ *                                               returns the error of the
+ *                                               first failed entry, errors
+ *                                               of all entries via
+ *                                               M22_24_GETBLOCK_CONFIG_ERR
+ *
+ *  M22_24_COUNTER_MODE          0..1            0 - events and signals
+ *                                               1 - count input edges only
+ *                                               of the current channel
+ *
+ *  M22_24_COUNTER_CLEAR         -               clears the edge counters of
+ *                                               the current channel
+ *
+ *  M22_24_MEAS_MODE             0..2            measurement of current channel
+ *                                               0 - off
+ *                                               1 - period of rising edges
+ *                                               2 - period of falling edges
+ *                                               (restarts the measurement)
+ *
+ *  M22_24_MEAS_GATE             0..x            measurement gate [ms]
+ *
+ *  M22_24_MEAS_CLEAR            -               restarts the measurement of
+ *                                               the current channel
+ *
+ *  M22_24_IRQ_STATS_CLEAR       -               clears the interrupt
+ *                                               statistics
+ *
+ *  M22_24_DEBOUNCE_US           0..x            debounce time of current
+ *                                               channel [us], 0 = off
+ *                                               (resolution: 1 tick)
+ *
+ *  M22_24_HYBRID_IRQ_RATE       0..x            irqs per second to switch to
+ *                                               polling, 0 = irqs only
+ *
+ *  M22_24_POLL_PERIOD           1..x            polling period [ms]
+ *
+ *  M22_24_POLL_MODE             0..1            0 - interrupts
+ *                                               1 - polling, no irqs
+ *
+ *  M22_PORT_OUTPUTS             0..0xff         sets the output switches of
+ *                                               all active channels, bit n =
+ *                                               channel n (M22 only)
+ *
+ *  M22_PORT_OUTPUTS_MODIFY      see below       clears, sets and toggles
+ *                                               output switches of active
+ *                                               channels in one call
+ *                                               (M22 only):
+ *                                               bit 7..0   set mask
+ *                                               bit 15..8  clear mask
+ *                                               bit 23..16 toggle mask
+ *                                               new = ((old & ~clear) | set)
+ *                                                     ^ toggle
+ *
+ *  M22_24_SHADOW_SYNC           -               reloads the shadow of the
+ *                                               output switch and irq enable
+ *                                               bits from the hardware
+ *
+ *  M22_24_BLK_READ_MODE         0..1            0 - all active channels
+ *                                               1 - changed channels only
+ *                                               (next read returns all)
+ *
+ *  M22_24_CACHED_READ           0..1            0 - read registers
+ *                                               1 - read inputs with both
+ *                                               edge irqs enabled from image
+ *                                               in scan irq mode, otherwise
+ *                                               from the registers
+ *
+ *  M22_SEQ_STOP                 -               stops the output sequencer,
+ *                                               outputs keep their state
+ *
+ *  M22_PWM_PERIOD               0..x            PWM period of current channel
+ *                                               [ms], 0 - off (output off)
+ *                                               rounded to the nearest tick,
+ *                                               min. 10 ticks
+ *
+ *  M22_PWM_DUTY                 0..1000         PWM duty cycle of current
+ *                                               channel [1/1000]
+ *
+ *  M22_PULSE                    0..x            switches the output of the
+ *                                               current channel on for the
+ *                                               given time [us], then off
+ *                                               (rounded up to n ticks, on
+ *                                               for n..n+1 ticks, min. 1
+ *                                               tick, retriggers, 0 = end
+ *                                               now)
+ *
+ *  M22_SIG_PULSE_DONE           signal number   installs signal sent when a
+ *                                               pulse ended
+ *
+ *  M22_SIG_CLR_PULSE_DONE       -               removes pulse done signal
+ *
+ *  M22_SETBLOCK_SEQ                             loads and starts the output
+ *                                               sequencer (M22 only)
+ *     blockStruct->size         size of M22_SEQ plus steps
+ *     blockStruct->data pointer                 M22_SEQ followed by nbrSteps
+ *                                               M22_SEQ_STEP
+ *                                               flags  - M22_SEQ_LOOP
+ *                                               period - loop period [ms]
+ *                                               (at least one tick)
+ *                                               step time - offset from
+ *                                               loop start [ms], rounded
+ *                                               to the nearest tick, not
+ *                                               decreasing
+ *                                               step mask - output switches
  *---------------------------------------------------------------------------
  *	Input......:  llHdl	 pointer to low-level driver data structure
  *				  code	 setstat code
@@ -789,6 +3965,7 @@ static int32 M22_SetStat
 		int32	retCode = 0;
 	int32	value;
 	INT32_OR_64		valueP;
+	OSS_IRQ_STATE	irqState;
 
 	value	= (int32)value32_or_64;	/* store 32bit value */
 	valueP	= value32_or_64;	/* store pointer     */
@@ -858,43 +4035,248 @@ static int32 M22_SetStat
 			break;
 
 			/*-----------------------+
-			  |  alarm edge mask of ch |
+			  |  alarm edge mask of ch |
+			  +-----------------------*/
+		case M22_ALARM_EDGE_MASK:
+			if( llHdl->modId != M22_MOD_ID )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: M22_ALARM_EDGE_MASK on M22 only %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					retCode = ERR_LL_ILL_PARAM;
+					break;
+				}
+			llHdl->alarmEdgeMask[ch] = (u_int8)( IRQ_ENABLE_MASK & ( value << 1 ));
+			/* reconfigure irq(s) */
+			configureIrqForChannel( llHdl, ch, llHdl->irqEnabled );
+			break;
+
+			/*--------------------+
+			  |  signal conditions  |
+			  +--------------------*/
+		case M22_24_SIG_EDGE_OCCURRED:
+			if( llHdl->sigHdl != NULL )	  /* already defined ? */
+				{
+					DBGWRT_ERR( ( DBH, "%s%s: signal	already	defined	%s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					return(ERR_OSS_SIG_SET);		   /* can't	set	! */
+				}/*if*/
+			retCode = OSS_SigCreate(	llHdl->osHdl, value, &llHdl->sigHdl );
+			break;
+
+		case M22_24_SIG_CLR_EDGE_OCCURRED:
+			retCode = OSS_SigRemove( llHdl->osHdl, &llHdl->sigHdl );
+			break;
+
+		case M22_24_SIG_UNSUBSCRIBE:
+			retCode = unsubscribe( llHdl, value );
+			break;
+
+			/*-----------------+
+			  |  edge counters	 |
+			  +-----------------*/
+		case M22_24_COUNTER_MODE:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			llHdl->counterMode[ch] = (u_int8)(value ? 1 : 0);
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+		case M22_24_COUNTER_CLEAR:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			llHdl->cntRising[ch]  = 0;
+			llHdl->cntFalling[ch] = 0;
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+			/*-----------------------------+
+			  |  frequency/period measurement |
+			  +-----------------------------*/
+		case M22_24_MEAS_MODE:
+			if( value < M22_24_MEAS_OFF || value > M22_24_MEAS_FALLING )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: M22_24_MEAS_MODE illegal value %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					retCode = ERR_LL_ILL_PARAM;
+					break;
+				}/*if*/
+			/* fall through */
+		case M22_24_MEAS_CLEAR:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			if( code == M22_24_MEAS_MODE )
+				llHdl->measMode[ch] = (u_int8)value;
+			OSS_MemFill( llHdl->osHdl, sizeof(M22_MEAS), (char*)&llHdl->meas[ch], 0 );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+		case M22_24_MEAS_GATE:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			measGateSet( llHdl, value );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+			/*-----------------------+
+			  |  debounce              |
+			  +-----------------------*/
+		case M22_24_DEBOUNCE_US:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			debounceSet( llHdl, (u_int8)ch, value );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+			/*-----------------------+
+			  |  polling / hybrid mode |
+			  +-----------------------*/
+		case M22_24_HYBRID_IRQ_RATE:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			hybridSet( llHdl, value );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+		case M22_24_POLL_PERIOD:
+			if( value < 1 )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: illegal poll period %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					retCode = ERR_LL_ILL_PARAM;
+					break;
+				}/*if*/
+			llHdl->pollPeriod = value;
+			break;
+
+		case M22_24_POLL_MODE:
+			if( value != M22_24_POLL_MODE_POLL &&
+				(value != M22_24_POLL_MODE_IRQ || !M22_USE_IRQ) )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: illegal poll mode %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					retCode = ERR_LL_ILL_PARAM;
+					break;
+				}/*if*/
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			llHdl->pollMode = value;
+			pollModeSet( llHdl, value );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+			/*-----------------------+
+			  |  port mode             |
+			  +-----------------------*/
+		case M22_PORT_OUTPUTS:
+		case M22_PORT_OUTPUTS_MODIFY:
+			if( llHdl->modId != M22_MOD_ID )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: M22_PORT_OUTPUTS_xxx on M22 only %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					retCode = ERR_LL_ILL_PARAM;
+					break;
+				}/*if*/
+			if( code == M22_PORT_OUTPUTS )
+				portWrite( llHdl, value );
+			else
+				portModify( llHdl, value );
+			break;
+
+		case M22_24_BLK_READ_MODE:
+			if( value != M22_24_BLK_READ_FULL && value != M22_24_BLK_READ_DELTA )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: illegal block read mode %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					retCode = ERR_LL_ILL_PARAM;
+					break;
+				}/*if*/
+			llHdl->blkReadMode = value;
+			OSS_MemFill( llHdl->osHdl, sizeof(llHdl->deltaLast),
+						 (char*)llHdl->deltaLast, M22_DELTA_INVALID );
+			break;
+
+		case M22_24_CACHED_READ:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			llHdl->cachedRead = value ? 1 : 0;
+			OSS_MemFill( llHdl->osHdl, sizeof(llHdl->imgValid),
+						 (char*)llHdl->imgValid, 0 );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+		case M22_SEQ_STOP:
+			seqStop( llHdl );
+			break;
+
+			/*-----------------------+
+			  |  software PWM          |
 			  +-----------------------*/
-		case M22_ALARM_EDGE_MASK:
-			if( llHdl->modId != M22_MOD_ID )
+		case M22_PWM_PERIOD:
+		case M22_PWM_DUTY:
+			if( llHdl->modId != M22_MOD_ID || !llHdl->activeCh[ch] ||
+				(code == M22_PWM_DUTY && value > 1000) )
 				{
-					DBGWRT_ERR(	( DBH, "%s%s: M22_ALARM_EDGE_MASK on M22 only %s%d%s",
+					DBGWRT_ERR(	( DBH, "%s%s: illegal PWM param or channel %s%d%s",
 								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
 					retCode = ERR_LL_ILL_PARAM;
 					break;
-				}
-			llHdl->alarmEdgeMask[ch] = (u_int8)( IRQ_ENABLE_MASK & ( value << 1 ));
-			/* reconfigure irq(s) */
-			configureIrqForChannel( llHdl, ch, llHdl->irqEnabled );
+				}/*if*/
+			if( code == M22_PWM_PERIOD )
+				retCode = pwmSet( llHdl, (u_int8)ch, value, llHdl->pwmDuty[ch] );
+			else
+				retCode = pwmSet( llHdl, (u_int8)ch, llHdl->pwmPeriod[ch], value );
 			break;
 
-			/*--------------------+
-			  |  signal conditions  |
-			  +--------------------*/
-		case M22_24_SIG_EDGE_OCCURRED:
-			if( llHdl->sigHdl != NULL )	  /* already defined ? */
+			/*-----------------------+
+			  |  one-shot pulse        |
+			  +-----------------------*/
+		case M22_PULSE:
+			if( llHdl->modId != M22_MOD_ID || !llHdl->activeCh[ch] ||
+				llHdl->pwmPeriodT[ch] )
 				{
-					DBGWRT_ERR( ( DBH, "%s%s: signal	already	defined	%s%d%s",
+					DBGWRT_ERR(	( DBH, "%s%s: M22_PULSE illegal channel or PWM %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					retCode = ERR_LL_ILL_PARAM;
+					break;
+				}/*if*/
+			retCode = pulseStart( llHdl, (u_int8)ch, value );
+			break;
+
+		case M22_SIG_PULSE_DONE:
+			if( llHdl->pulseSigHdl != NULL )	  /* already defined ? */
+				{
+					DBGWRT_ERR( ( DBH, "%s%s: pulse signal already defined %s%d%s",
 								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
 					return(ERR_OSS_SIG_SET);		   /* can't	set	! */
 				}/*if*/
-			retCode = OSS_SigCreate(	llHdl->osHdl, value, &llHdl->sigHdl );
+			retCode = OSS_SigCreate( llHdl->osHdl, value, &llHdl->pulseSigHdl );
 			break;
 
-		case M22_24_SIG_CLR_EDGE_OCCURRED:
-			retCode = OSS_SigRemove( llHdl->osHdl, &llHdl->sigHdl );
+		case M22_SIG_CLR_PULSE_DONE:
+			retCode = OSS_SigRemove( llHdl->osHdl, &llHdl->pulseSigHdl );
+			break;
+
+		case M22_24_SHADOW_SYNC:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			shadowSync( llHdl );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+			/*-----------------------+
+			  |  interrupt statistics  |
+			  +-----------------------*/
+		case M22_24_IRQ_STATS_CLEAR:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			OSS_MemFill( llHdl->osHdl, sizeof(llHdl->irqChCount), (char*)llHdl->irqChCount, 0 );
+			OSS_MemFill( llHdl->osHdl, sizeof(llHdl->isrHist), (char*)llHdl->isrHist, 0 );
+			llHdl->irqSpurious	= 0;
+			llHdl->sigSendErr	= 0;
+			llHdl->isrTimeMin	= 0;
+			llHdl->isrTimeMax	= 0;
+			llHdl->isrTimeSum	= 0;
+			llHdl->isrTimeCnt	= 0;
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
 			break;
 
 			/*-----------------------+
 			  |  clear occurred edges  |
 			  +-----------------------*/
 		case M22_24_CLEAR_INPUT_EDGE:
-			MCLRMASK_D16(llHdl->ma, IOREG(ch), EDGE_OCCURRED_MASK );
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			shadowWrite( llHdl, (u_int8)ch, 0, EDGE_OCCURRED_MASK );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
 			llHdl->stateBuf[ch] &= ~(EDGE_OCCURRED_MASK >> 3);
 			break;
 
@@ -906,10 +4288,71 @@ static int32 M22_SetStat
 					retCode = ERR_LL_ILL_PARAM;
 					break;
 				}
-			MCLRMASK_D16(llHdl->ma, ALARMREG(ch), EDGE_OCCURRED_MASK );
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			shadowWrite( llHdl, (u_int8)ch, 1, EDGE_OCCURRED_MASK );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
 			llHdl->alarmStateBuf[ch] &= ~(EDGE_OCCURRED_MASK >> 3);
 			break;
 
+			/*-----------------+
+			  |  event buffer	 |
+			  +-----------------*/
+		case M22_24_EVENT_COUNT:
+			if( value != 0 )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: M22_24_EVENT_COUNT only 0 allowed %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					retCode = ERR_LL_ILL_PARAM;
+					break;
+				}
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			llHdl->evOut	= llHdl->evIn;
+			llHdl->evCount	= 0;
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+		case M22_24_EVENT_LOST:
+			llHdl->evLost = value;
+			break;
+
+			/*-----------------+
+			  |  irq mode		 |
+			  +-----------------*/
+		case M22_24_IRQ_MODE:
+			if( value != M22_24_IRQ_MODE_INTREG && value != M22_24_IRQ_MODE_SCAN )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: illegal irq mode %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					retCode = ERR_LL_ILL_PARAM;
+					break;
+				}
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			if( value == M22_24_IRQ_MODE_SCAN && llHdl->irqMode != M22_24_IRQ_MODE_SCAN )
+				{
+					scanFlush( llHdl );
+					/* image not maintained since the last scan mode */
+					OSS_MemFill( llHdl->osHdl, sizeof(llHdl->imgValid),
+								 (char*)llHdl->imgValid, 0 );
+				}/*if*/
+			llHdl->irqMode = value;
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+			/*---------------------+
+			  |  signal coalescing |
+			  +---------------------*/
+		case M22_24_SIG_HOLDOFF:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			llHdl->sigHoldoff = value;
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+		case M22_24_SIG_THRESHOLD:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			llHdl->sigThreshold = value;
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
 			/*----------------+
 			  |  default		  |
 			  +----------------*/
@@ -997,6 +4440,142 @@ static int32 M22_SetStat
  *     blockStruct->data pointer                 user buffer containing the
  *                                               alarm data (starting with ch #0)
  *                                               M22 only
+ *
+ *  M22_24_EVENT_COUNT           0..x            number of buffered events
+ *
+ *  M22_24_EVENT_LOST            0..x            number of events lost due to
+ *                                               event buffer overflow
+ *
+ *  M22_24_TICK_RATE             ticks/s         rate of event time stamps
+ *
+ *  M22_24_IRQ_MODE              0..1            0 - INTREG channel only
+ *                                               1 - scan all active channels
+ *
+ *  M22_24_SIG_HOLDOFF           0..x            signal holdoff time [ms]
+ *
+ *  M22_24_SIG_THRESHOLD         0..x            number of edges per signal
+ *
+ *  M22_24_SIG_PENDING           0..x            number of edges since the
+ *                                               last call (reset on read)
+ *
+ *  M22_24_SIG_SUBSCRIBERS       0..8            number of signal subscribers
+ *
+ *  M22_24_COUNTER_MODE          0..1            counter mode of current channel
+ *
+ *  M22_24_GETBLOCK_COUNTERS                     gets the rising and falling
+ *                                               edge counters of all channels
+ *     blockStruct->size         0..x            buffer size [bytes], returns
+ *                                               number of bytes read
+ *     blockStruct->data pointer                 user buffer for M22_24_COUNTER
+ *                                               records (starting with ch #0)
+ *
+ *  M22_24_GETBLOCK_COUNTERS_CLR                 as M22_24_GETBLOCK_COUNTERS
+ *                                               but clears the read counters
+ *                                               (atomic read and reset)
+ *
+ *  M22_24_MEAS_MODE             0..2            measurement of current channel
+ *
+ *  M22_24_MEAS_GATE             0..x            measurement gate [ms]
+ *
+ *  M22_24_DEBOUNCE_US           0..x            debounce time of current
+ *                                               channel [us]
+ *
+ *  M22_PWM_PERIOD               0..x            effective PWM period of
+ *                                               current channel [ms]
+ *                                               (whole ticks)
+ *
+ *  M22_PWM_DUTY                 0..1000         effective PWM duty cycle of
+ *                                               current channel [1/1000]
+ *                                               (whole ticks, PWM on)
+ *
+ *  M22_PULSE                    0..1            1 - pulse running on current
+ *                                               channel
+ *
+ *  M22_SIG_PULSE_DONE           0..x            signal number of the pulse
+ *                                               done signal
+ *
+ *  M22_24_HYBRID_IRQ_RATE       0..x            irqs per second to switch to
+ *                                               polling
+ *
+ *  M22_24_POLL_PERIOD           1..x            polling period [ms]
+ *
+ *  M22_24_POLL_MODE             0..1            0 - interrupts
+ *                                               1 - polling, no irqs
+ *
+ *  M22_24_BLK_READ_MODE         0..1            0 - all active channels
+ *                                               1 - changed channels only
+ *
+ *  M22_24_CACHED_READ           0..1            read from irq image
+ *
+ *  M22_24_PORT_INPUTS           0..0xffff       input values of all channels,
+ *                                               bit n = channel n
+ *
+ *  M22_PORT_OUTPUTS             0..0xff         output switches of all
+ *                                               channels (M22 only)
+ *
+ *  M22_PORT_ALARMS              0..0xff         alarm values of all channels
+ *                                               (M22 only)
+ *
+ *  M22_24_GETBLOCK_PORT                         gets inputs, output switches
+ *                                               and alarms of all channels
+ *     blockStruct->size         size of M22_24_PORT
+ *     blockStruct->data pointer                 user buffer for M22_24_PORT
+ *
+ *  M22_GETBLOCK_SEQ_STATUS                      gets the output sequencer
+ *                                               progress
+ *     blockStruct->size         size of M22_SEQ_STATUS
+ *     blockStruct->data pointer                 user buffer for M22_SEQ_STATUS
+ *
+ *  M22_24_POLL_ACTIVE           0..1            1 - irqs disabled, polling
+ *
+ *  M22_24_HYBRID_COUNT          0..x            number of switches from
+ *                                               irqs to polling
+ *
+ *  M22_24_MEAS_PERIOD           0..x            mean period of the last gate
+ *                                               of the current channel [us]
+ *
+ *  M22_24_MEAS_PERIOD_MIN       0..x            min/max of the gate mean
+ *  M22_24_MEAS_PERIOD_MAX                       periods since (re)start [us],
+ *                                               not of single periods
+ *
+ *  M22_24_MEAS_FREQ             0..x            smoothed frequency of the
+ *                                               current channel [mHz],
+ *                                               0 if edges stopped
+ *
+ *  M22_24_GETBLOCK_MEAS                         gets the measurement results
+ *                                               of all channels
+ *     blockStruct->size         0..x            buffer size [bytes], returns
+ *                                               number of bytes read
+ *     blockStruct->data pointer                 user buffer for M22_24_MEAS
+ *                                               records (starting with ch #0)
+ *
+ *  M22_24_GETBLOCK_IRQ_STATS                    gets the interrupt statistics
+ *     blockStruct->size         size of M22_24_IRQ_STATS
+ *     blockStruct->data pointer                 user buffer for M22_24_IRQ_STATS
+ *                                               timeRate 0: ISR time not
+ *                                               measured (no M22_STAT_TIME)
+ *
+ *  M22_24_GETBLOCK_EVENTS                       reads and removes the oldest
+ *                                               buffered events
+ *     blockStruct->size         0..x            buffer size [bytes], returns
+ *                                               number of bytes read
+ *     blockStruct->data pointer                 user buffer for M22_24_EVENT
+ *                                               records
+ *
+ *  M22_24_GETBLOCK_WAIT_EVENT                   waits for the next event
+ *                                               (oldest buffered event if
+ *                                               the event buffer is used)
+ *     blockStruct->size         sizeof(M22_24_WAIT)
+ *     blockStruct->data pointer                 M22_24_WAIT, timeout [ms]
+ *                                               0 - no wait, -1 - endless
+ *                                               returns ERR_OSS_TIMEOUT
+ *                                               if no event occurred
+ *
+ *  M22_24_GETBLOCK_CONFIG_ERR                   gets the errors of the
+ *                                               entries of the last
+ *                                               M22_24_SETBLOCK_CONFIG
+ *     blockStruct->size         n * sizeof(int32)
+ *     blockStruct->data pointer                 int32 per entry, 0 = ok
  *---------------------------------------------------------------------------
  *	Input......:  llHdl	   pointer to low-level	driver data	structure
  *				  code	   getstat code
@@ -1023,6 +4602,9 @@ static int32 M22_GetStat
 	u_int8 rdVal;
 	int32 *valueP = (int32*)value32_or_64P; /* pointer to 32bit value */
 	INT32_OR_64 *value64P = value32_or_64P; /* stores 32/64bit pointer */
+	OSS_IRQ_STATE irqState;
+	M22_24_MEAS meas;
+	M22_24_PORT port;
 	DBGCMD( static const char functionName[] = "LL - M22_GetStat:" );
 
 	DBGWRT_1((DBH, "%s code=$%04lx\n", functionName, code) );
@@ -1156,6 +4738,154 @@ static int32 M22_GetStat
 			llHdl->alarmStateBuf[ch] |= (EDGE_OCCURRED_MASK & rdVal) >> 3;
 			break;
 
+			/*-----------------+
+			  |  event buffer	 |
+			  +-----------------*/
+		case M22_24_EVENT_COUNT:
+			*valueP	= llHdl->evCount;
+			break;
+
+		case M22_24_EVENT_LOST:
+			*valueP	= llHdl->evLost;
+			break;
+
+		case M22_24_TICK_RATE:
+			*valueP	= OSS_TickRateGet( llHdl->osHdl );
+			break;
+
+		case M22_24_IRQ_MODE:
+			*valueP	= llHdl->irqMode;
+			break;
+
+		case M22_24_SIG_HOLDOFF:
+			*valueP	= llHdl->sigHoldoff;
+			break;
+
+		case M22_24_SIG_THRESHOLD:
+			*valueP	= llHdl->sigThreshold;
+			break;
+
+		case M22_24_SIG_PENDING:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			*valueP	= llHdl->sigPending;
+			llHdl->sigPending = 0;
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+			break;
+
+		case M22_24_SIG_SUBSCRIBERS:
+			*valueP	= llHdl->subscrCount;
+			break;
+
+		case M22_24_COUNTER_MODE:
+			*valueP	= llHdl->counterMode[ch];
+			break;
+
+		case M22_24_MEAS_MODE:
+			*valueP	= llHdl->measMode[ch];
+			break;
+
+		case M22_24_MEAS_GATE:
+			*valueP	= llHdl->measGate;
+			break;
+
+		case M22_24_DEBOUNCE_US:
+			*valueP	= llHdl->debUs[ch];
+			break;
+
+		case M22_PWM_PERIOD:
+		case M22_PWM_DUTY:
+			if( llHdl->modId != M22_MOD_ID )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: M22_PWM_xxx on M22 only %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					retCode = ERR_LL_ILL_PARAM;
+					break;
+				}/*if*/
+			if( code == M22_PWM_PERIOD )
+				*valueP = ticksToMs( llHdl, llHdl->pwmPeriodT[ch] );
+			else if( llHdl->pwmPeriodT[ch] && llHdl->pwmPeriodT[ch] < 0x400000 )
+				*valueP = (llHdl->pwmOnT[ch] * 1000 + llHdl->pwmPeriodT[ch] / 2) /
+					llHdl->pwmPeriodT[ch];
+			else
+				*valueP = llHdl->pwmDuty[ch];	/* off or exact to 1/1000 */
+			break;
+
+		case M22_PULSE:
+			*valueP	= ch < 8 ? llHdl->pulseActive[ch] : 0;
+			break;
+
+		case M22_SIG_PULSE_DONE:
+			OSS_SigInfo( llHdl->osHdl, llHdl->pulseSigHdl, valueP, &processId );
+			break;
+
+		case M22_24_HYBRID_IRQ_RATE:
+			*valueP	= llHdl->hybRate;
+			break;
+
+		case M22_24_POLL_PERIOD:
+			*valueP	= llHdl->pollPeriod;
+			break;
+
+		case M22_24_POLL_MODE:
+			*valueP	= llHdl->pollMode;
+			break;
+
+		case M22_24_BLK_READ_MODE:
+			*valueP	= llHdl->blkReadMode;
+			break;
+
+		case M22_24_CACHED_READ:
+			*valueP	= llHdl->cachedRead;
+			break;
+
+			/*-----------------+
+			  |  port mode	 |
+			  +-----------------*/
+		case M22_PORT_OUTPUTS:
+		case M22_PORT_ALARMS:
+			if( llHdl->modId != M22_MOD_ID )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: M22_PORT_xxx on M22 only %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					retCode = ERR_LL_ILL_PARAM;
+					break;
+				}/*if*/
+			/* fall through */
+		case M22_24_PORT_INPUTS:
+			portRead( llHdl, &port );
+			if( code == M22_24_PORT_INPUTS )
+				*valueP = port.inputs;
+			else if( code == M22_PORT_OUTPUTS )
+				*valueP = port.outputs;
+			else
+				*valueP = port.alarms;
+			break;
+
+		case M22_24_POLL_ACTIVE:
+			*valueP	= llHdl->pollActive != M22_POLL_OFF;
+			break;
+
+		case M22_24_HYBRID_COUNT:
+			*valueP	= llHdl->hybCount;
+			break;
+
+		case M22_24_MEAS_PERIOD:
+		case M22_24_MEAS_PERIOD_MIN:
+		case M22_24_MEAS_PERIOD_MAX:
+		case M22_24_MEAS_FREQ:
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			measGet( llHdl, (u_int8)ch, &meas );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+			switch( code )
+				{
+				case M22_24_MEAS_PERIOD:		*valueP = meas.gatePeriod;		break;
+				case M22_24_MEAS_PERIOD_MIN:	*valueP = meas.gatePeriodMin;	break;
+				case M22_24_MEAS_PERIOD_MAX:	*valueP = meas.gatePeriodMax;	break;
+				default:						*valueP = meas.freq;
+				}/*switch*/
+			break;
+
 			/*--------------------+
 			  |  (unknown)		  |
 			  +--------------------*/
@@ -1199,6 +4929,12 @@ static int32 M22_GetStat
  *             RE:  rising edge occurred
  *             I:   input state
  *             r:   reserved
+ *
+ *  In block read mode M22_24_BLK_READ_DELTA only the channels whose
+ *  state byte changed since the last block read are stored, as
+ *  M22_24_DELTA records (channel, state byte). The number of records is
+ *  *nbrRdBytesP / sizeof(M22_24_DELTA). Changes which don't fit into the
+ *  buffer are returned by the next call.
  *---------------------------------------------------------------------------
  *	Input......:  llHdl		   pointer to low-level	driver data	structure
  *				  ch		   current channel (always ignored)
@@ -1227,14 +4963,46 @@ static int32 M22_BlockRead
 	int32  nbrRdBytes = 0;
 	u_int8 rdVal;
 	u_int8 *buffer = (u_int8*) buf;
+	M22_24_DELTA *deltaP = (M22_24_DELTA*) buf;
 
 	DBGWRT_1((DBH, "%s\n", functionName) );
 
+	if( llHdl->blkReadMode == M22_24_BLK_READ_DELTA )
+		{
+			for( ch	= 0; ch	< llHdl->nbrOfChannels; ch++ )
+				{
+					if( !llHdl->activeCh[ch] )
+						continue;
+					if( nbrRdBytes + (int32)sizeof(M22_24_DELTA) > size )
+						break;
+
+					rdVal = ioRead( llHdl, (u_int8)ch );
+					if( rdVal & IOREG_INPUT_OR_ALARM_VAL )
+						llHdl->stateBuf[ch] |= M22_24_READ_INPUT;
+					else
+						llHdl->stateBuf[ch] &= ~M22_24_READ_INPUT;
+					llHdl->stateBuf[ch] |= (EDGE_OCCURRED_MASK & rdVal) >> 3;
+
+					/* report changed channels only */
+					if( llHdl->stateBuf[ch] == llHdl->deltaLast[ch] )
+						continue;
+
+					llHdl->deltaLast[ch] = llHdl->stateBuf[ch];
+					deltaP->ch	  = (u_int8)ch;
+					deltaP->state = llHdl->stateBuf[ch];
+					deltaP++;
+					nbrRdBytes += sizeof(M22_24_DELTA);
+				}/*for*/
+
+			*nbrRdBytesP = nbrRdBytes;
+			return(	retCode );
+		}/*if*/
+
 	for( ch	= 0; ch	< llHdl->nbrOfChannels; ch++ )
 		{
 			if( llHdl->activeCh[ch] && nbrRdBytes < size )
 				{
-					rdVal  = (u_int8) MREAD_D16( llHdl->ma,	IOREG(ch) );
+					rdVal  = ioRead( llHdl, (u_int8)ch );
 
 					/* update state buffer
 					 * - set/reset input bit
@@ -1304,30 +5072,24 @@ static int32 M22_BlockWrite
 	int32 nbrWrBytes = 0;
 	u_int8 *buffer = (u_int8*) buf;
 	u_int8 value;
+	OSS_IRQ_STATE irqState;
 
 	DBGWRT_1((DBH, "%s\n", functionName) );
 
+	irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
 	for( ch	= 0; ch	< llHdl->nbrOfChannels; ch++ )
 		{
 			if( llHdl->activeCh[ch] && nbrWrBytes < size )
 				{
 					value = (u_int8)*buffer++;
 
-					/* update state buffer - set output switch */
-					if (value)
-						{
-							llHdl->stateBuf[ch] |= M22_READ_OUTPUT_SWITCH;      /* set output switch bit */
-							MSETMASK_D16(llHdl->ma, IOREG(ch), IOREG_OUTPUT_SWITCH );
-						}
-					else
-						{
-							llHdl->stateBuf[ch] &= ~M22_READ_OUTPUT_SWITCH;      /* reset output switch bit */
-							MCLRMASK_D16(llHdl->ma, IOREG(ch), IOREG_OUTPUT_SWITCH );
-						}/*if*/
+					/* update state buffer and output switch */
+					outputSet( llHdl, (u_int8)ch, (u_int8)(value ? 1 : 0) );
 
 					nbrWrBytes++;
 				}/*if*/
 		}/*for*/
+	OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
 
 	*nbrWrBytesP = nbrWrBytes;
 	return(	retCode );
@@ -1341,7 +5103,8 @@ static int32 M22_BlockWrite
  *
  *                The function clears the edge flag registers.
  *                If the signal is installed (setstat code M22_SIG_EDGE_OCCURRED)
- *                this is sent.
+ *                this is sent, or delayed according to M22_24_SIG_HOLDOFF and
+ *                M22_24_SIG_THRESHOLD.
  *
  *                The function clears the M-Module IRQ and stores the number of
  *                the channel that triggered the interrupt.
@@ -1350,6 +5113,19 @@ static int32 M22_BlockWrite
  *                The function increments the M-Module irq counter if an edge was
  *                detected.
  *               (getstat code M_LL_IRQ_COUNT)
+ *
+ *                The channel, edge direction and a time stamp are stored as
+ *                event record and waiting callers are woken up.
+ *                (getstat codes M22_24_GETBLOCK_EVENTS, M22_24_GETBLOCK_WAIT_EVENT)
+ *
+ *                In M22_24_IRQ_MODE_SCAN the INTREG channel is ignored. All
+ *                active channels are scanned for pending edges instead, so
+ *                simultaneous edges are not lost. The found edges are cleared
+ *                in the hardware and kept in the read state buffer.
+ *
+ *                Input edges of channels in counter mode are only counted,
+ *                they don't create events or signals.
+ *                (getstat code M22_24_GETBLOCK_COUNTERS)
  *---------------------------------------------------------------------------
  *	Input......:  llHdl	 pointer to	low-level driver data structure
  *
@@ -1363,7 +5139,10 @@ static int32 M22_Irq
  LL_HANDLE *llHdl
  )
 {
-	u_int8	   ch, intreg, alarm;
+	u_int8	   ch, intreg, alarm = 0;
+	u_int8	   reg, enMask;
+	int32	   nbrOfEdges = 1;
+	u_int32	   hits, startTime = M22_STAT_TIME( llHdl );
 
 	IDBGWRT_1( ( DBH, ">>> M22_Irq:\n") );
 
@@ -1372,6 +5151,17 @@ static int32 M22_Irq
 	  +----------------------*/
 	intreg = (u_int8) MREAD_D16( llHdl->ma,	INTREG ); /* get irq source, reset	irq	! */
 
+	if( llHdl->irqMode == M22_24_IRQ_MODE_SCAN )
+		{
+			/* don't trust INTREG, collect the edges of all channels */
+			hits = llHdl->scanHits;
+			nbrOfEdges = scanEdges( llHdl );
+			if( hits == llHdl->scanHits )
+				llHdl->irqSpurious++;
+			IDBGWRT_2( ( DBH,">>> M22_Irq: scan edges=%d\n", nbrOfEdges ) );
+			goto SIGNAL;
+		}/*if*/
+
 	if( llHdl->modId == M22_MOD_ID )
 		{
 			ch 		= (u_int8)((intreg & M22_IRQ_CH_NBR)	>> 1);						  /* channel caused irq */
@@ -1385,15 +5175,52 @@ static int32 M22_Irq
 		}
 
 	/*----------------------+
-	  | handle signal	cond.	|
+	  | store event			|
 	  +----------------------*/
-	/* send	signal */
-	if(	llHdl->sigHdl != NULL )
-		if(	OSS_SigSend( llHdl->osHdl,	llHdl->sigHdl ) )
-			IDBGWRT_ERR( ( DBH,	">>>  M22_Irq: OSS_SigSend failed\n") );
+	if( alarm )
+		{
+			reg	   = (u_int8) MREAD_D16( llHdl->ma, ALARMREG(ch) );
+			enMask = llHdl->alarmEdgeMask[ch];
+			llHdl->alarmEdges[ch] = (u_int8)(reg & EDGE_OCCURRED_MASK);
+		}
+	else
+		{
+			reg	   = (u_int8) MREAD_D16( llHdl->ma, IOREG(ch) );
+			enMask = llHdl->inputEdgeMask[ch];
+			llHdl->ioEdges[ch]	  = (u_int8)(reg & EDGE_OCCURRED_MASK);
+		}/*if*/
+
+	/* no enabled edge occurred at reported channel? */
+	if( !(((reg & EDGE_OCCURRED_MASK) >> 3) & enMask) )
+		llHdl->irqSpurious++;
+	else
+		llHdl->irqChCount[ch]++;
+
+	if( alarm )
+		nbrOfEdges = pushEvent( llHdl, ch, (u_int8)(edgeFlags( reg, enMask ) | M22_EV_ALARM) );
+	else if( llHdl->counterMode[ch] )
+		{
+			/* count (and clear) both edges of short pulses */
+			nbrOfEdges = scanReg( llHdl, ch, 0 );
+		}
+	else
+		nbrOfEdges = pushEvent( llHdl, ch, edgeFlags( reg, enMask ) );
 
 	llHdl->irqSource =	ch;				 /*	stores the irq source */
+
+	/*----------------------+
+	  | handle signal	cond.	|
+	  +----------------------*/
+ SIGNAL:
+	/* send	signal (or collect edges for it) */
+	if( nbrOfEdges )
+		notifyEdges( llHdl, nbrOfEdges );
+
 	llHdl->irqCount++;
+	if( llHdl->hybRate )
+		hybridCheck( llHdl );
+	if( M22_STAT_TIME_RATE( llHdl ) )
+		irqStatTime( llHdl, M22_STAT_TIME( llHdl ) - startTime );
 
 	return(	LL_IRQ_UNKNOWN ); /* don't really know, if it's a shared interrupt */
 }/*M22_Irq*/
@@ -1426,6 +5253,7 @@ static int32 M22_Irq
  *
  *	LL_INFO_IRQ
  *	   arg2	 u_int32 *useIrqP		   1			  module uses interrupts
+ *										   0			  m22_nirq variant (polling)
  *
  *	LL_INFO_LOCKMODE
  *	   arg2  u_int32 *lockModeP		LL_LOCK_CALL	used lockmode
@@ -1488,7 +5316,7 @@ static int32 M22_Info
 
 		case LL_INFO_IRQ:
 			useIrqP  = va_arg( argptr, u_int32* );
-			*useIrqP = 1;
+			*useIrqP = M22_USE_IRQ;
 			break;
 
 		case LL_INFO_LOCKMODE:
@@ -1536,6 +5364,11 @@ static int32 getStatBlock     /*nodoc*/
 	u_int32	maxWords;
 	u_int16	*dataP;
 	int32   nbrRdBytes=0;
+	M22_24_EVENT	*evP;
+	M22_24_COUNTER	*cntP;
+	M22_24_MEAS		*measP;
+	u_int32	n, maxEv;
+	OSS_IRQ_STATE	irqState;
 
 	DBGWRT_1((DBH, "%s\n", functionName) );
 
@@ -1580,6 +5413,110 @@ static int32 getStatBlock     /*nodoc*/
 				}/*for*/
 			break;
 
+		case M22_24_GETBLOCK_EVENTS:
+			if( llHdl->evBuf == NULL )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: no event buffer %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					return( ERR_LL_ILL_PARAM );
+				}
+			evP	  = (M22_24_EVENT*)(blockStruct->data);
+			maxEv = blockStruct->size / sizeof(M22_24_EVENT);
+
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			for( n = 0; n < maxEv && llHdl->evCount; n++ )
+				{
+					*evP++ = llHdl->evBuf[llHdl->evOut];
+					if( ++llHdl->evOut == llHdl->evMax )
+						llHdl->evOut = 0;
+					llHdl->evCount--;
+				}/*for*/
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+			blockStruct->size = n * sizeof(M22_24_EVENT);
+			break;
+
+		case M22_24_GETBLOCK_COUNTERS:
+		case M22_24_GETBLOCK_COUNTERS_CLR:
+			cntP = (M22_24_COUNTER*)(blockStruct->data);
+			n	 = blockStruct->size / sizeof(M22_24_COUNTER);
+			if( n > (u_int32)llHdl->nbrOfChannels )
+				n = llHdl->nbrOfChannels;
+
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			for( ch = 0; ch < (int32)n; ch++ )
+				{
+					cntP[ch].rising	 = llHdl->cntRising[ch];
+					cntP[ch].falling = llHdl->cntFalling[ch];
+					if( code == M22_24_GETBLOCK_COUNTERS_CLR )
+						{
+							llHdl->cntRising[ch]  = 0;
+							llHdl->cntFalling[ch] = 0;
+						}/*if*/
+				}/*for*/
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+			blockStruct->size = n * sizeof(M22_24_COUNTER);
+			break;
+
+		case M22_24_GETBLOCK_MEAS:
+			measP = (M22_24_MEAS*)(blockStruct->data);
+			n	  = blockStruct->size / sizeof(M22_24_MEAS);
+			if( n > (u_int32)llHdl->nbrOfChannels )
+				n = llHdl->nbrOfChannels;
+
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			for( ch = 0; ch < (int32)n; ch++ )
+				measGet( llHdl, (u_int8)ch, &measP[ch] );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+			blockStruct->size = n * sizeof(M22_24_MEAS);
+			break;
+
+		case M22_24_GETBLOCK_IRQ_STATS:
+			if( blockStruct->size < (int32)sizeof(M22_24_IRQ_STATS) )
+				return( ERR_LL_USERBUF );
+
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			irqStatGet( llHdl, (M22_24_IRQ_STATS*)blockStruct->data );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+			blockStruct->size = sizeof(M22_24_IRQ_STATS);
+			break;
+
+		case M22_24_GETBLOCK_PORT:
+			if( blockStruct->size < (int32)sizeof(M22_24_PORT) )
+				return( ERR_LL_USERBUF );
+			portRead( llHdl, (M22_24_PORT*)blockStruct->data );
+			blockStruct->size = sizeof(M22_24_PORT);
+			break;
+
+		case M22_24_GETBLOCK_CONFIG_ERR:
+			n = blockStruct->size / sizeof(int32);
+			if( n > llHdl->cfgNbr )
+				n = llHdl->cfgNbr;
+			for( i = 0; i < n; i++ )
+				((int32*)blockStruct->data)[i] = llHdl->cfgErr[i];
+			blockStruct->size = n * sizeof(int32);
+			break;
+
+		case M22_GETBLOCK_SEQ_STATUS:
+			if( blockStruct->size < (int32)sizeof(M22_SEQ_STATUS) )
+				return( ERR_LL_USERBUF );
+
+			irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+			seqStatusGet( llHdl, (M22_SEQ_STATUS*)blockStruct->data );
+			OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
+
+			blockStruct->size = sizeof(M22_SEQ_STATUS);
+			break;
+
+		case M22_24_GETBLOCK_WAIT_EVENT:
+			if( blockStruct->size < (int32)sizeof(M22_24_WAIT) )
+				return( ERR_LL_USERBUF );
+			error = waitEvent( llHdl, (M22_24_WAIT*)(blockStruct->data) );
+			break;
+
 		default:
 			DBGWRT_ERR( ( DBH, "%s%s:  unkown blockgetstat code %s%d%s",
 						  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
@@ -1615,6 +5552,7 @@ static int32 setStatBlock     /*nodoc*/
 {
 	DBGCMD(	static const char functionName[] = "LL - setStatBlock:";	)
 		int32	error, ch;
+	OSS_IRQ_STATE	irqState;
 
 	DBGWRT_1((DBH, "%s\n", functionName) );
 
@@ -1626,7 +5564,9 @@ static int32 setStatBlock     /*nodoc*/
 				{
 					if( llHdl->activeCh[ch] )
 						{
-							MCLRMASK_D16(llHdl->ma, IOREG(ch), EDGE_OCCURRED_MASK );
+							irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+							shadowWrite( llHdl, (u_int8)ch, 0, EDGE_OCCURRED_MASK );
+							OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
 							llHdl->stateBuf[ch] &= ~(EDGE_OCCURRED_MASK >> 3);
 						}/*if*/
 				}/*for*/
@@ -1643,12 +5583,38 @@ static int32 setStatBlock     /*nodoc*/
 				{
 					if( llHdl->activeCh[ch] )
 						{
-							MCLRMASK_D16(llHdl->ma, ALARMREG(ch), EDGE_OCCURRED_MASK );
+							irqState = OSS_IrqMaskR( llHdl->osHdl, llHdl->irqHdl );
+							shadowWrite( llHdl, (u_int8)ch, 1, EDGE_OCCURRED_MASK );
+							OSS_IrqRestore( llHdl->osHdl, llHdl->irqHdl, irqState );
 							llHdl->alarmStateBuf[ch] &= ~(EDGE_OCCURRED_MASK >> 3);
 						}/*if*/
 				}/*for*/
 			break;
 
+		case M22_24_SETBLOCK_SIG_SUBSCRIBE:
+			if( blockStruct->size < (int32)sizeof(M22_24_SUBSCRIBE) )
+				return( ERR_LL_USERBUF );
+			error = subscribe( llHdl, (M22_24_SUBSCRIBE*)(blockStruct->data) );
+			break;
+
+		case M22_24_SETBLOCK_CONFIG:
+			if( blockStruct->size < (int32)sizeof(M22_24_CONFIG) ||
+				blockStruct->size > (int32)(M22_24_CONFIG_MAX * sizeof(M22_24_CONFIG)) )
+				return( ERR_LL_USERBUF );
+			error = configSet( llHdl, (M22_24_CONFIG*)(blockStruct->data),
+							   blockStruct->size / sizeof(M22_24_CONFIG) );
+			break;
+
+		case M22_SETBLOCK_SEQ:
+			if( llHdl->modId != M22_MOD_ID )
+				{
+					DBGWRT_ERR(	( DBH, "%s%s: M22_SETBLOCK_SEQ on M22 only %s%d%s",
+								  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
+					return( ERR_LL_ILL_PARAM );
+				}
+			error = seqSet( llHdl, (M22_SEQ*)(blockStruct->data), blockStruct->size );
+			break;
+
 		default:
 			DBGWRT_ERR( ( DBH, "%s%s:  unkown blockgetstat code %s%d%s",
 						  errorStartStr, functionName, errorLineStr, __LINE__, errorEndStr ));
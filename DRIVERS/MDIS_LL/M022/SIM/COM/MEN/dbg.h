@@ -0,0 +1,45 @@
+/***********************  I n c l u d e  -  F i l e  ************************
+ *
+ *         Name: dbg.h
+ *
+ *  Description: debug macros, compiled out in the simulation
+ *
+ *               Host simulation stub, see ../sim.h. Only the definitions
+ *               used by the M22 driver and tools are provided; numeric
+ *               values are local to the simulation.
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _DBG_H
+#define _DBG_H
+
+typedef struct DBG_HANDLE DBG_HANDLE;
+
+#define DBGCMD(_x_)
+#define DBGINIT(_x_)
+#define DBGEXIT(_x_)
+#define DBGWRT_1(_x_)
+#define DBGWRT_2(_x_)
+#define DBGWRT_3(_x_)
+#define DBGWRT_ERR(_x_)
+#define IDBGWRT_1(_x_)
+#define IDBGWRT_2(_x_)
+#define IDBGWRT_3(_x_)
+#define IDBGWRT_ERR(_x_)
+
+#endif /* _DBG_H */
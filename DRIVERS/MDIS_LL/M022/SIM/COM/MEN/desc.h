@@ -0,0 +1,43 @@
+/***********************  I n c l u d e  -  F i l e  ************************
+ *
+ *         Name: desc.h
+ *
+ *  Description: descriptor access, implemented by sim_oss.c
+ *
+ *               Host simulation stub, see ../sim.h. Only the definitions
+ *               used by the M22 driver and tools are provided; numeric
+ *               values are local to the simulation.
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _DESC_H
+#define _DESC_H
+
+/* the simulated descriptor is a "KEY=value" text, see sim.h */
+typedef void				DESC_SPEC;
+typedef struct DESC_HANDLE	DESC_HANDLE;
+
+extern int32 DESC_Init( DESC_SPEC *descSpec, OSS_HANDLE *osHdl,
+						DESC_HANDLE **descHandleP );
+extern int32 DESC_Exit( DESC_HANDLE **descHandleP );
+extern int32 DESC_GetUInt32( DESC_HANDLE *descHandle, u_int32 defVal,
+							 u_int32 *valueP, char *keyFmt, ... );
+extern int32 DESC_DbgLevelSet( DESC_HANDLE *descHandle, u_int32 dbgLevel );
+extern char *DESC_Ident( void );
+
+#endif /* _DESC_H */
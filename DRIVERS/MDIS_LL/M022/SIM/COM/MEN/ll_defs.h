@@ -0,0 +1,52 @@
+/***********************  I n c l u d e  -  F i l e  ************************
+ *
+ *         Name: ll_defs.h
+ *
+ *  Description: low-level driver definitions
+ *
+ *               Host simulation stub, see ../sim.h. Only the definitions
+ *               used by the M22 driver and tools are provided; numeric
+ *               values are local to the simulation.
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _LL_DEFS_H
+#define _LL_DEFS_H
+
+#ifndef _NO_LL_HANDLE
+	typedef void LL_HANDLE;
+#endif
+
+/* irq return codes */
+#define LL_IRQ_DEV_NOT				0
+#define LL_IRQ_DEVICE				1
+#define LL_IRQ_UNKNOWN				2
+
+/* info codes */
+#define LL_INFO_HW_CHARACTER		1
+#define LL_INFO_ADDRSPACE_COUNT		2
+#define LL_INFO_ADDRSPACE			3
+#define LL_INFO_IRQ					4
+#define LL_INFO_LOCKMODE			5
+
+/* lock modes */
+#define LL_LOCK_NONE				0
+#define LL_LOCK_CHAN				1
+#define LL_LOCK_CALL				2
+
+#endif /* _LL_DEFS_H */
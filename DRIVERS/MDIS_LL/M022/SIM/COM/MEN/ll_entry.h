@@ -0,0 +1,50 @@
+/***********************  I n c l u d e  -  F i l e  ************************
+ *
+ *         Name: ll_entry.h
+ *
+ *  Description: low-level driver jump table
+ *
+ *               Host simulation stub, see ../sim.h. Only the definitions
+ *               used by the M22 driver and tools are provided; numeric
+ *               values are local to the simulation.
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _LL_ENTRY_H
+#define _LL_ENTRY_H
+
+typedef struct {
+	int32 (*init)( DESC_SPEC *descSpec, OSS_HANDLE *osHdl, MACCESS *ma,
+				   OSS_SEM_HANDLE *devSemHdl, OSS_IRQ_HANDLE *irqHdl,
+				   LL_HANDLE **llHdlP );
+	int32 (*exit)( LL_HANDLE **llHdlP );
+	int32 (*read)( LL_HANDLE *llHdl, int32 ch, int32 *value );
+	int32 (*write)( LL_HANDLE *llHdl, int32 ch, int32 value );
+	int32 (*blockRead)( LL_HANDLE *llHdl, int32 ch, void *buf, int32 size,
+						int32 *nbrRdBytesP );
+	int32 (*blockWrite)( LL_HANDLE *llHdl, int32 ch, void *buf, int32 size,
+						 int32 *nbrWrBytesP );
+	int32 (*setStat)( LL_HANDLE *llHdl, int32 code, int32 ch,
+					  INT32_OR_64 value );
+	int32 (*getStat)( LL_HANDLE *llHdl, int32 code, int32 ch,
+					  INT32_OR_64 *valueP );
+	int32 (*irq)( LL_HANDLE *llHdl );
+	int32 (*info)( int32 infoType, ... );
+} LL_ENTRY;
+
+#endif /* _LL_ENTRY_H */
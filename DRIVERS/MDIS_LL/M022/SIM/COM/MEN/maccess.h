@@ -0,0 +1,44 @@
+/***********************  I n c l u d e  -  F i l e  ************************
+ *
+ *         Name: maccess.h
+ *
+ *  Description: register access macros, routed to the M22/M24 model
+ *
+ *               Host simulation stub, see ../sim.h. Only the definitions
+ *               used by the M22 driver and tools are provided; numeric
+ *               values are local to the simulation.
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _MACCESS_H
+#define _MACCESS_H
+
+/* MACCESS is the simulated module itself */
+typedef struct SIM_MOD *MACCESS;
+
+extern u_int16 SIM_Read16( MACCESS ma, u_int32 offs );
+extern void SIM_Write16( MACCESS ma, u_int32 offs, u_int16 val );
+
+#define MREAD_D16(ma,offs)			SIM_Read16( (ma), (offs) )
+#define MWRITE_D16(ma,offs,val)		SIM_Write16( (ma), (offs), (u_int16)(val) )
+#define MSETMASK_D16(ma,offs,mask)	\
+	MWRITE_D16( ma, offs, MREAD_D16( ma, offs ) | (mask) )
+#define MCLRMASK_D16(ma,offs,mask)	\
+	MWRITE_D16( ma, offs, MREAD_D16( ma, offs ) & ~(mask) )
+
+#endif /* _MACCESS_H */
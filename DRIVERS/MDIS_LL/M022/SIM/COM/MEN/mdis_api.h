@@ -0,0 +1,81 @@
+/***********************  I n c l u d e  -  F i l e  ************************
+ *
+ *         Name: mdis_api.h
+ *
+ *  Description: MDIS user API, implemented by sim_mdis.c
+ *
+ *               Host simulation stub, see ../sim.h. Only the definitions
+ *               used by the M22 driver and tools are provided; numeric
+ *               values are local to the simulation.
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _MDIS_API_H
+#define _MDIS_API_H
+
+/* status code ranges */
+#define M_MK_OF				0x0000
+#define M_LL_OF				0x0100
+#define M_DEV_OF			0x0200
+#define M_MK_BLK_OF			0x8000
+#define M_LL_BLK_OF			0x8100
+#define M_DEV_BLK_OF		0x8200
+
+/* MDIS kernel codes */
+#define M_MK_IRQ_ENABLE		(M_MK_OF+0x0c)
+#define M_MK_CH_CURRENT		(M_MK_OF+0x0d)
+#define M_MK_IO_MODE		(M_MK_OF+0x0e)
+#define M_MK_BLK_REV_ID		(M_MK_BLK_OF+0x00)
+
+/* low-level driver codes */
+#define M_LL_CH_NUMBER		(M_LL_OF+0x00)
+#define M_LL_CH_DIR			(M_LL_OF+0x01)
+#define M_LL_CH_LEN			(M_LL_OF+0x02)
+#define M_LL_CH_TYP			(M_LL_OF+0x03)
+#define M_LL_IRQ_COUNT		(M_LL_OF+0x04)
+#define M_LL_ID_CHECK		(M_LL_OF+0x05)
+#define M_LL_DEBUG_LEVEL	(M_LL_OF+0x06)
+#define M_LL_ID_SIZE		(M_LL_OF+0x07)
+#define M_LL_BLK_ID_DATA	(M_LL_BLK_OF+0x00)
+
+/* channel characteristics */
+#define M_CH_IN				0
+#define M_CH_OUT			1
+#define M_CH_INOUT			2
+#define M_CH_BINARY			0
+
+/* i/o modes */
+#define M_IO_EXEC			0
+
+typedef struct {
+	int32	size;
+	void	*data;
+} M_SETGETSTAT_BLOCK;
+
+extern int32 M_open( const char *device );
+extern int32 M_close( int32 path );
+extern int32 M_read( int32 path, int32 *valueP );
+extern int32 M_write( int32 path, int32 value );
+extern int32 M_getstat( int32 path, int32 code, int32 *dataP );
+extern int32 M_setstat( int32 path, int32 code, INT32_OR_64 data );
+extern int32 M_getblock( int32 path, u_int8 *buffer, int32 length );
+extern int32 M_setblock( int32 path, const u_int8 *buffer, int32 length );
+extern char *M_errstring( int32 errCode );
+extern char *M_errstringTs( int32 errCode, char *strBuf );
+
+#endif /* _MDIS_API_H */
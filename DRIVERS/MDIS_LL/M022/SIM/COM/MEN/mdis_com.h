@@ -0,0 +1,43 @@
+/***********************  I n c l u d e  -  F i l e  ************************
+ *
+ *         Name: mdis_com.h
+ *
+ *  Description: MDIS common definitions
+ *
+ *               Host simulation stub, see ../sim.h. Only the definitions
+ *               used by the M22 driver and tools are provided; numeric
+ *               values are local to the simulation.
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _MDIS_COM_H
+#define _MDIS_COM_H
+
+#define MDIS_MA08			0x01
+#define MDIS_MD08			0x01
+#define MDIS_MD16			0x02
+
+#define MDIS_MAX_IDENT		8
+
+typedef struct {
+	struct {
+		char *(*identCall)( void );
+	} idCall[MDIS_MAX_IDENT];
+} MDIS_IDENT_FUNCT_TBL;
+
+#endif /* _MDIS_COM_H */
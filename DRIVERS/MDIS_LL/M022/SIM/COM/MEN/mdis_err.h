@@ -0,0 +1,64 @@
+/***********************  I n c l u d e  -  F i l e  ************************
+ *
+ *         Name: mdis_err.h
+ *
+ *  Description: MDIS error codes
+ *
+ *               Host simulation stub, see ../sim.h. Only the definitions
+ *               used by the M22 driver and tools are provided; numeric
+ *               values are local to the simulation.
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _MDIS_ERR_H
+#define _MDIS_ERR_H
+
+#define ERR_OS					0x0000
+
+#define ERR_MK					0x0400
+#define ERR_MK_ILL_PARAM		(ERR_MK+0x01)
+#define ERR_MK_UNK_CODE			(ERR_MK+0x02)
+#define ERR_MK_NO_LLDRV			(ERR_MK+0x03)
+#define ERR_MK_USERBUF			(ERR_MK+0x04)
+#define ERR_MK_ILL_PATH			(ERR_MK+0x05)
+
+#define ERR_OSS					0x0600
+#define ERR_OSS_MEM_ALLOC		(ERR_OSS+0x01)
+#define ERR_OSS_SIG_SET			(ERR_OSS+0x02)
+#define ERR_OSS_TIMEOUT			(ERR_OSS+0x03)
+#define ERR_OSS_SIG_OCCURED		(ERR_OSS+0x04)
+#define ERR_OSS_BUSY_RESOURCE	(ERR_OSS+0x05)
+#define ERR_OSS_ILL_PARAM		(ERR_OSS+0x06)
+
+#define ERR_LL					0x0a00
+#define ERR_LL_ILL_ID			(ERR_LL+0x01)
+#define ERR_LL_DESC_PARAM		(ERR_LL+0x02)
+#define ERR_LL_ILL_CHAN			(ERR_LL+0x03)
+#define ERR_LL_ILL_PARAM		(ERR_LL+0x04)
+#define ERR_LL_UNK_CODE			(ERR_LL+0x05)
+#define ERR_LL_USERBUF			(ERR_LL+0x06)
+#define ERR_LL_READ				(ERR_LL+0x07)
+#define ERR_LL_WRITE			(ERR_LL+0x08)
+#define ERR_LL_ILL_FUNC			(ERR_LL+0x09)
+
+#define ERR_DESC				0x0b00
+#define ERR_DESC_KEY_NOTFOUND	(ERR_DESC+0x01)
+
+#define ERR_DEV					0x0e00
+
+#endif /* _MDIS_ERR_H */
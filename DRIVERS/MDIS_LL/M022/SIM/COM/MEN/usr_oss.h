@@ -0,0 +1,58 @@
+/***********************  I n c l u d e  -  F i l e  ************************
+ *
+ *         Name: usr_oss.h
+ *
+ *  Description: user OSS functions, implemented by sim_mdis.c
+ *
+ *               Host simulation stub, see ../sim.h. Only the definitions
+ *               used by the M22 driver and tools are provided; numeric
+ *               values are local to the simulation.
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _USR_OSS_H
+#define _USR_OSS_H
+
+#define UOS_SIG_USR1		1
+#define UOS_SIG_USR2		2
+#define UOS_SIG_USR3		3
+#define UOS_SIG_USR4		4
+
+#define UOS_ERRSTRING_SIZE	256
+
+extern int32 UOS_MikroDelayInit( void );
+extern int32 UOS_MikroDelay( u_int32 usec );
+extern int32 UOS_Delay( u_int32 msec );
+extern u_int32 UOS_MsecTimerGet( void );
+extern u_int32 UOS_MsecTimerResolution( void );
+extern u_int32 UOS_ErrnoGet( void );
+extern u_int32 UOS_ErrnoSet( u_int32 errCode );
+extern char *UOS_ErrString( int32 errCode );
+extern char *UOS_ErrStringTs( int32 errCode, char *strBuf );
+extern int32 UOS_SigInit( void (*sigHandler)(u_int32 sigCode) );
+extern int32 UOS_SigExit( void );
+extern int32 UOS_SigInstall( u_int32 sigCode );
+extern int32 UOS_SigRemove( u_int32 sigCode );
+extern void UOS_SigMask( void );
+extern void UOS_SigUnMask( void );
+extern int32 UOS_KeyPressed( void );
+extern int32 UOS_KeyWait( void );
+extern u_int32 UOS_Random( u_int32 old );
+extern u_int32 UOS_RandomMap( u_int32 val, u_int32 ra, u_int32 re );
+
+#endif /* _USR_OSS_H */
@@ -0,0 +1,1045 @@
+/*********************  P r o g r a m  -  M o d u l e ***********************
+ *
+ *         Name: m22_simtest.c
+ *
+ *  Description: regression test and benchmark of m22_drv.c on the
+ *               register-level simulator
+ *
+ *               Checks the driver against the module model: register
+ *               contents after configuration, INTREG and scan irq mode,
+ *               block reads, timers, event wait, signal coalescing and
+ *               subscribers, hybrid and polling mode, cached reads, edge
+ *               counters, period measurement, debounce, the output
+ *               sequencer, the edge flag write back and memory cleanup.
+ *               With -t only the tests depending on the OSS tick rate
+ *               (timers, debounce, sequencer) run, see SIM_HZ in the
+ *               Makefile.
+ *               With -b the hot paths M22_Irq, M22_BlockRead and
+ *               configureIrqForChannel are timed with the host clock.
+ *
+ *     Required: libm22sim.a
+ *     Switches: -
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <MEN/men_typs.h>
+#include <MEN/oss.h>
+#include <MEN/usr_oss.h>
+#include <MEN/mdis_api.h>
+#include <MEN/mdis_err.h>
+#include <MEN/m22_drv.h>
+
+#include "sim.h"
+
+/*-----------------------------------------+
+|  DEFINES                                 |
++------------------------------------------*/
+#define CHK(expr)	do { if( !(expr) ){ \
+						printf( "    *** line %d: %s\n", __LINE__, #expr ); \
+						return( 1 ); } } while(0)
+
+#define REG_OUTPUT		0x01
+#define REG_EN_RISING	0x02
+#define REG_EN_FALLING	0x04
+
+#define BENCH_LOOPS		100000
+
+#define TICK_MS			(1000 / SIM_TICK_RATE)	/* OSS tick [ms] */
+
+/*-----------------------------------------+
+|  STATICS                                 |
++------------------------------------------*/
+static SIM_MOD	*G_m22, *G_m24;
+static int32	G_m22Fd = -1, G_m24Fd = -1;
+static u_int32	G_sigCount, G_sig2Count;
+
+/*-----------------------------------------+
+|  PROTOTYPES                              |
++------------------------------------------*/
+static void sigHandler( u_int32 sigNo );
+static int32 getBlock( int32 fd, int32 code, void *data, int32 size );
+static int32 setBlock( int32 fd, int32 code, void *data, int32 size );
+static int32 getStat( int32 fd, int32 ch, int32 code );
+static int32 setStat( int32 fd, int32 ch, int32 code, int32 value );
+static int testConfig( void );
+static int testIntreg( void );
+static int testScan( void );
+static int testBlockRead( void );
+static int testTimers( void );
+static int testWaitEvent( void );
+static int testCoalesce( void );
+static int testHybrid( void );
+static int testPollMode( void );
+static int testCachedRead( void );
+static int testSubscribe( void );
+static int testCounters( void );
+static int testMeas( void );
+static int testDebounce( void );
+static int testSeq( void );
+static void bench( u_int32 loops );
+
+/********************************* main *************************************
+ *
+ *  Description:  Run the tests and optionally the benchmark.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  argc, argv   [-t] [-b [<loops>]]
+ *  Output.....:  return 0 = all tests passed, 1 = error
+ *  Globals....:  -
+ ****************************************************************************/
+int main( int argc, char *argv[] )
+{
+	static const struct {
+		const char	*name;
+		int			(*func)( void );
+		int			tick;		/* depends on the tick rate */
+	} test[] = {
+		{ "configureIrqForChannel",	testConfig,		0 },
+		{ "INTREG irq mode",		testIntreg,		0 },
+		{ "scan irq mode",			testScan,		0 },
+		{ "M_getblock",				testBlockRead,	0 },
+		{ "PWM and pulse timers",	testTimers,		1 },
+		{ "wait for event",			testWaitEvent,	0 },
+		{ "signal coalescing",		testCoalesce,	0 },
+		{ "hybrid irq/polling",		testHybrid,		0 },
+		{ "polling mode",			testPollMode,	0 },
+		{ "cached read",			testCachedRead,	0 },
+		{ "signal subscribers",		testSubscribe,	0 },
+		{ "edge counters",			testCounters,	0 },
+		{ "period measurement",		testMeas,		0 },
+		{ "debounce",				testDebounce,	1 },
+		{ "output sequencer",		testSeq,		1 },
+	};
+	char buf[UOS_ERRSTRING_SIZE], desc[1024];
+	u_int32 i, n, failed = 0;
+	int tickOnly = argc > 1 && !strcmp( argv[1], "-t" );
+
+	if( tickOnly ){
+		argc--;
+		argv++;
+	}
+
+	printf( "M22/M24 driver test on the simulator, %d ticks/s\n",
+			SIM_TICK_RATE );
+
+	/* all edges enabled, separate irq lines, no loopback skew needed */
+	n = (u_int32)sprintf( desc, "IRQ_ENABLE=1 EVENT_BUF_SIZE=256" );
+	for( i = 0; i < M24_MAX_CH; i++ )
+		n += (u_int32)sprintf( desc + n, " CHANNEL_%u/INPUT_EDGE_MASK=3",
+							   (unsigned)i );
+	G_m22 = SIM_DevCreate( "m22_sim", 22, desc );
+	G_m24 = SIM_DevCreate( "m24_sim", 24, desc );
+	SIM_Loopback( G_m22, G_m24, 0 );
+
+	if( UOS_SigInit( sigHandler ) || UOS_SigInstall( UOS_SIG_USR1 ) ||
+		UOS_SigInstall( UOS_SIG_USR2 ) ||
+		(G_m22Fd = M_open( "m22_sim" )) < 0 ||
+		(G_m24Fd = M_open( "m24_sim" )) < 0 ||
+		M_setstat( G_m24Fd, M22_24_SIG_EDGE_OCCURRED, UOS_SIG_USR1 ) ){
+		printf( "*** init: %s\n", M_errstringTs( (int32)UOS_ErrnoGet(), buf ) );
+		return( 1 );
+	}
+
+	for( i = 0; i < sizeof(test) / sizeof(test[0]); i++ ){
+		if( tickOnly && !test[i].tick )
+			continue;
+		printf( "%-24s", test[i].name );
+		fflush( stdout );
+		if( test[i].func() )
+			failed++;
+		else
+			printf( "    => OK\n" );
+	}
+
+	if( argc > 1 && !strcmp( argv[1], "-b" ) )
+		bench( argc > 2 ? (u_int32)strtoul( argv[2], NULL, 0 ) : BENCH_LOOPS );
+
+	M_close( G_m22Fd );
+	M_close( G_m24Fd );
+	UOS_SigRemove( UOS_SIG_USR1 );
+	UOS_SigRemove( UOS_SIG_USR2 );
+	UOS_SigExit();
+
+	printf( "%-24s", "edge flag write back" );
+	if( G_m22->edgeSetWr || G_m24->edgeSetWr ){
+		printf( "    *** %u writes of 1 to clear edge flags\n",
+				(unsigned)(G_m22->edgeSetWr + G_m24->edgeSetWr) );
+		failed++;
+	}
+	else
+		printf( "    => OK\n" );
+
+	printf( "%-24s", "memory cleanup" );
+	if( SIM_MemBlocks() ){
+		printf( "    *** %d blocks not freed\n", (int)SIM_MemBlocks() );
+		failed++;
+	}
+	else
+		printf( "    => OK\n" );
+
+	printf( "=== %s ===\n", failed ? "ERROR" : "OK" );
+	return( failed ? 1 : 0 );
+}
+
+/********************************* testConfig *******************************
+ *
+ *  Description:  Irq enables in the hardware follow the configuration,
+ *                an oversized event buffer is rejected.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testConfig( void )
+{
+	u_int32 wr;
+
+	CHK( getStat( G_m22Fd, 0, M_LL_CH_NUMBER ) == M22_MAX_CH );
+	CHK( getStat( G_m24Fd, 0, M_LL_CH_NUMBER ) == M24_MAX_CH );
+
+	/* one register write per edge mask change */
+	wr = G_m24->wrCount;
+	CHK( !setStat( G_m24Fd, 3, M22_24_INPUT_EDGE_MASK,
+				   M22_24_RISING_EDGE_ENABLE ) );
+	CHK( G_m24->wrCount - wr == 1 );
+	CHK( (G_m24->ioReg[3] & (REG_EN_RISING | REG_EN_FALLING)) == REG_EN_RISING );
+
+	CHK( !setStat( G_m24Fd, 3, M22_24_INPUT_EDGE_MASK,
+				   M22_24_RISING_EDGE_ENABLE | M22_24_FALLING_EDGE_ENABLE ) );
+	CHK( (G_m24->ioReg[3] & (REG_EN_RISING | REG_EN_FALLING)) ==
+		 (REG_EN_RISING | REG_EN_FALLING) );
+
+	/* inactive channel and disabled irq clear the enables */
+	CHK( !setStat( G_m24Fd, 3, M22_24_CHANNEL_INACTIVE, 1 ) );
+	CHK( (G_m24->ioReg[3] & (REG_EN_RISING | REG_EN_FALLING)) == 0 );
+	CHK( !setStat( G_m24Fd, 3, M22_24_CHANNEL_INACTIVE, 0 ) );
+	CHK( G_m24->ioReg[3] & REG_EN_RISING );
+
+	CHK( !M_setstat( G_m24Fd, M_MK_IRQ_ENABLE, 0 ) );
+	CHK( (G_m24->ioReg[3] & (REG_EN_RISING | REG_EN_FALLING)) == 0 );
+	CHK( !M_setstat( G_m24Fd, M_MK_IRQ_ENABLE, 1 ) );
+	CHK( G_m24->ioReg[3] & REG_EN_FALLING );
+
+	/* M22 outputs and loopback */
+	CHK( !setStat( G_m22Fd, 0, M22_PORT_OUTPUTS, 0x81 ) );
+	CHK( G_m22->ioReg[0] & REG_OUTPUT );
+	CHK( G_m22->ioReg[7] & REG_OUTPUT );
+	CHK( G_m24->level[0] && G_m24->level[8] && !G_m24->level[1] );
+	CHK( !setStat( G_m22Fd, 0, M22_PORT_OUTPUTS, 0 ) );
+	CHK( !G_m24->level[7] && !G_m24->level[15] );
+
+	/* inactive M22 channel can't be written */
+	CHK( !setStat( G_m22Fd, 5, M22_24_CHANNEL_INACTIVE, 1 ) );
+	CHK( M_write( G_m22Fd, 1 ) && UOS_ErrnoGet() == ERR_LL_ILL_CHAN );
+	CHK( !setStat( G_m22Fd, 5, M22_24_CHANNEL_INACTIVE, 0 ) );
+
+	/* event buffer too large to allocate */
+	CHK( SIM_DevCreate( "m24_big", 24, "EVENT_BUF_SIZE=0x15555556" ) );
+	CHK( M_open( "m24_big" ) < 0 && UOS_ErrnoGet() == ERR_LL_ILL_PARAM );
+	SIM_DevRemove( "m24_big" );
+
+	return( 0 );
+}
+
+/********************************* testIntreg *******************************
+ *
+ *  Description:  Simultaneous edges lose irqs in INTREG mode.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testIntreg( void )
+{
+	OSS_IRQ_STATE state;
+	int32 irqs;
+	u_int32 lost = G_m24->irqLost;
+
+	CHK( !setStat( G_m24Fd, 0, M22_24_IRQ_MODE, M22_24_IRQ_MODE_INTREG ) );
+	CHK( !setStat( G_m24Fd, 0, M22_24_EVENT_COUNT, 0 ) );
+	irqs = getStat( G_m24Fd, 0, M_LL_IRQ_COUNT );
+	G_sigCount = 0;
+
+	/* single edge: reported channel, event, signal */
+	SIM_InputSet( G_m24, 9, 1 );
+	CHK( getStat( G_m24Fd, 0, M_LL_IRQ_COUNT ) == irqs + 1 );
+	CHK( getStat( G_m24Fd, 0, M22_24_IRQ_SOURCE ) == 9 );
+	CHK( getStat( G_m24Fd, 0, M22_24_EVENT_COUNT ) == 1 );
+	CHK( G_sigCount == 1 );
+
+	/* two edges before the isr runs: one is reported only */
+	state = OSS_IrqMaskR( SIM_OssHandle(), NULL );
+	SIM_InputSet( G_m24, 10, 1 );
+	SIM_InputSet( G_m24, 12, 1 );
+	OSS_IrqRestore( SIM_OssHandle(), NULL, state );
+	CHK( getStat( G_m24Fd, 0, M_LL_IRQ_COUNT ) == irqs + 2 );
+	CHK( getStat( G_m24Fd, 0, M22_24_EVENT_COUNT ) == 2 );
+	CHK( G_m24->irqLost == lost + 1 );
+
+	SIM_InputSet( G_m24, 9, 0 );
+	SIM_InputSet( G_m24, 10, 0 );
+	SIM_InputSet( G_m24, 12, 0 );
+	return( 0 );
+}
+
+/********************************* testScan *********************************
+ *
+ *  Description:  Scan irq mode recovers simultaneous edges.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testScan( void )
+{
+	M22_24_EVENT ev[8];
+	OSS_IRQ_STATE state;
+	int32 size, value;
+
+	CHK( !setStat( G_m24Fd, 0, M22_24_IRQ_MODE, M22_24_IRQ_MODE_SCAN ) );
+	CHK( !setStat( G_m24Fd, 0, M22_24_EVENT_COUNT, 0 ) );
+
+	state = OSS_IrqMaskR( SIM_OssHandle(), NULL );
+	SIM_InputSet( G_m24, 4, 1 );
+	SIM_InputSet( G_m24, 13, 1 );
+	SIM_InputSet( G_m24, 14, 1 );
+	OSS_IrqRestore( SIM_OssHandle(), NULL, state );
+
+	size = getBlock( G_m24Fd, M22_24_GETBLOCK_EVENTS, ev, sizeof(ev) );
+	CHK( size == 3 * (int32)sizeof(M22_24_EVENT) );
+	CHK( ev[0].ch == 4 && ev[1].ch == 13 && ev[2].ch == 14 );
+	CHK( ev[0].flags & M22_24_READ_RISING_EDGE );
+	CHK( ev[1].seqNbr == ev[0].seqNbr + 1 );
+
+	/* edge flags cleared in the hardware, kept for M_read */
+	CHK( (G_m24->edges[13] & 0x30) == 0 );
+	CHK( !M_setstat( G_m24Fd, M_MK_CH_CURRENT, 13 ) );
+	CHK( !M_read( G_m24Fd, &value ) );
+	CHK( value == (M22_24_READ_INPUT | M22_24_READ_RISING_EDGE) );
+
+	SIM_InputSet( G_m24, 4, 0 );
+	SIM_InputSet( G_m24, 13, 0 );
+	SIM_InputSet( G_m24, 14, 0 );
+	CHK( !setStat( G_m24Fd, 0, M22_24_IRQ_MODE, M22_24_IRQ_MODE_INTREG ) );
+	return( 0 );
+}
+
+/********************************* testBlockRead ****************************
+ *
+ *  Description:  Full and delta block read.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testBlockRead( void )
+{
+	u_int8 buf[M24_MAX_CH];
+	M22_24_DELTA delta[M24_MAX_CH];
+	M22_24_CONFIG cfg;
+	int32 n;
+
+	/* clear the edges of the previous tests */
+	cfg.ch = 0;
+	cfg.code = M22_24_CLEAR_INPUT_EDGE;
+	cfg.value = 0;
+	for( n = 0; n < M24_MAX_CH; n++ ){
+		cfg.ch = n;
+		CHK( !setBlock( G_m24Fd, M22_24_SETBLOCK_CONFIG, &cfg, sizeof(cfg) ) );
+	}
+
+	SIM_InputSet( G_m24, 6, 1 );
+	CHK( M_getblock( G_m24Fd, buf, sizeof(buf) ) == M24_MAX_CH );
+	CHK( buf[6] == (M22_24_READ_INPUT | M22_24_READ_RISING_EDGE) );
+	CHK( buf[5] == 0 );
+
+	/* delta: first read reports all, then the changes only */
+	CHK( !setStat( G_m24Fd, 0, M22_24_BLK_READ_MODE, M22_24_BLK_READ_DELTA ) );
+	n = M_getblock( G_m24Fd, (u_int8*)delta, sizeof(delta) );
+	CHK( n == M24_MAX_CH * (int32)sizeof(M22_24_DELTA) );
+	CHK( M_getblock( G_m24Fd, (u_int8*)delta, sizeof(delta) ) == 0 );
+	SIM_InputSet( G_m24, 2, 1 );
+	n = M_getblock( G_m24Fd, (u_int8*)delta, sizeof(delta) );
+	CHK( n == (int32)sizeof(M22_24_DELTA) && delta[0].ch == 2 );
+	CHK( !setStat( G_m24Fd, 0, M22_24_BLK_READ_MODE, M22_24_BLK_READ_FULL ) );
+
+	SIM_InputSet( G_m24, 2, 0 );
+	SIM_InputSet( G_m24, 6, 0 );
+	return( 0 );
+}
+
+/********************************* testTimers *******************************
+ *
+ *  Description:  PWM and pulse outputs on the simulated time line,
+ *                PWM period limit and effective period and duty cycle.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testTimers( void )
+{
+	u_int32 edges;
+
+	/* 10 ticks period, 50%: 20 edges in 10 periods, +2 at start/stop */
+	edges = G_m22->edgeCount;
+	CHK( !setStat( G_m22Fd, 1, M22_PWM_DUTY, 500 ) );
+	CHK( setStat( G_m22Fd, 1, M22_PWM_PERIOD, 9 * TICK_MS ) );
+	CHK( UOS_ErrnoGet() == ERR_LL_ILL_PARAM );
+	CHK( !setStat( G_m22Fd, 1, M22_PWM_PERIOD, 10 * TICK_MS ) );
+	UOS_Delay( 100 * TICK_MS );
+	edges = G_m22->edgeCount - edges;
+	CHK( edges >= 20 && edges <= 22 );
+
+	/* effective values: on time of 3.33 ticks rounded */
+	CHK( !setStat( G_m22Fd, 1, M22_PWM_DUTY, 333 ) );
+	CHK( getStat( G_m22Fd, 1, M22_PWM_PERIOD ) == 10 * TICK_MS );
+	CHK( getStat( G_m22Fd, 1, M22_PWM_DUTY ) == 300 );
+	CHK( !setStat( G_m22Fd, 1, M22_PWM_PERIOD, 0 ) );
+	CHK( getStat( G_m22Fd, 1, M22_PWM_PERIOD ) == 0 );
+	CHK( !(G_m22->ioReg[1] & REG_OUTPUT) );
+
+	/* 5 ticks pulse: on for 5..6 ticks, below one tick rejected */
+	CHK( setStat( G_m22Fd, 2, M22_PULSE, TICK_MS * 1000 - 1 ) );
+	CHK( UOS_ErrnoGet() == ERR_LL_ILL_PARAM );
+	SIM_Stall( TICK_MS * 1000 - 1 -		/* start at the end of a tick */
+			   (u_int32)(SIM_TimeUs() % (TICK_MS * 1000)) );
+	CHK( !setStat( G_m22Fd, 2, M22_PULSE, 5 * TICK_MS * 1000 ) );
+	CHK( G_m22->ioReg[2] & REG_OUTPUT );
+	UOS_Delay( 5 * TICK_MS );
+	CHK( getStat( G_m22Fd, 2, M22_PULSE ) == 1 );
+	CHK( G_m22->ioReg[2] & REG_OUTPUT );
+	UOS_Delay( TICK_MS );
+	CHK( !(G_m22->ioReg[2] & REG_OUTPUT) );
+	CHK( getStat( G_m22Fd, 2, M22_PULSE ) == 0 );
+
+	return( 0 );
+}
+
+/********************************* testWaitEvent ****************************
+ *
+ *  Description:  Blocking wait for a scheduled edge and timeout.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testWaitEvent( void )
+{
+	M22_24_WAIT wt;
+	u_int32 start;
+
+	CHK( !setStat( G_m24Fd, 0, M22_24_EVENT_COUNT, 0 ) );
+
+	SIM_InputAt( G_m24, 3000, 1, 1 );
+	start = (u_int32)(SIM_TimeUs() / 1000);
+	wt.timeout = 100;
+	CHK( getBlock( G_m24Fd, M22_24_GETBLOCK_WAIT_EVENT, &wt, sizeof(wt) ) ==
+		 (int32)sizeof(wt) );
+	CHK( wt.ev.ch == 1 && (wt.ev.flags & M22_24_READ_RISING_EDGE) );
+	CHK( wt.ev.timeStamp - start == 3 );
+
+	wt.timeout = 20;
+	CHK( getBlock( G_m24Fd, M22_24_GETBLOCK_WAIT_EVENT, &wt, sizeof(wt) ) < 0 );
+	CHK( UOS_ErrnoGet() == ERR_OSS_TIMEOUT );
+
+	SIM_InputSet( G_m24, 1, 0 );
+	return( 0 );
+}
+
+/********************************* testCoalesce *****************************
+ *
+ *  Description:  Signal threshold and holdoff. A threshold without
+ *                holdoff sends the remaining edges after 100ms.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testCoalesce( void )
+{
+	u_int32 i;
+
+	CHK( !setStat( G_m24Fd, 0, M22_24_SIG_THRESHOLD, 3 ) );
+	getStat( G_m24Fd, 0, M22_24_SIG_PENDING );
+	G_sigCount = 0;
+
+	/* 5 edges: one signal at the 3rd, 2 held */
+	for( i = 0; i < 5; i++ )
+		SIM_InputSet( G_m24, 1, (i + 1) & 1 );
+	CHK( getStat( G_m24Fd, 0, M22_24_SIG_PENDING ) == 5 );
+	CHK( G_sigCount == 1 );
+	UOS_Delay( 90 );
+	CHK( G_sigCount == 1 );
+	UOS_Delay( 20 );
+	CHK( G_sigCount == 2 );
+
+	/* holdoff only: the first edge starts 10ms */
+	CHK( !setStat( G_m24Fd, 0, M22_24_SIG_THRESHOLD, 0 ) );
+	CHK( !setStat( G_m24Fd, 0, M22_24_SIG_HOLDOFF, 10 ) );
+	SIM_InputSet( G_m24, 1, 0 );
+	SIM_InputSet( G_m24, 1, 1 );
+	UOS_Delay( 5 );
+	SIM_InputSet( G_m24, 1, 0 );
+	CHK( G_sigCount == 2 );
+	UOS_Delay( 6 );
+	CHK( G_sigCount == 3 );
+
+	CHK( !setStat( G_m24Fd, 0, M22_24_SIG_HOLDOFF, 0 ) );
+	return( 0 );
+}
+
+/********************************* testHybrid *******************************
+ *
+ *  Description:  An irq storm switches to polling and back. Edges
+ *                reported in INTREG mode are not reported again.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testHybrid( void )
+{
+	int32 count, irqs;
+	u_int32 i;
+
+	/* max. 10 irqs per 100ms window */
+	CHK( !setStat( G_m24Fd, 0, M22_24_POLL_PERIOD, 5 ) );
+	CHK( !setStat( G_m24Fd, 0, M22_24_HYBRID_IRQ_RATE, 100 ) );
+	CHK( !setStat( G_m24Fd, 0, M22_24_EVENT_COUNT, 0 ) );
+	count = getStat( G_m24Fd, 0, M22_24_HYBRID_COUNT );
+	irqs  = getStat( G_m24Fd, 0, M_LL_IRQ_COUNT );
+
+	/* the 11th irq starts polling, the 12th edge is polled */
+	for( i = 0; i < 12; i++ )
+		SIM_InputSet( G_m24, 2, (i + 1) & 1 );
+	CHK( getStat( G_m24Fd, 0, M22_24_POLL_ACTIVE ) );
+	CHK( getStat( G_m24Fd, 0, M22_24_HYBRID_COUNT ) == count + 1 );
+	CHK( getStat( G_m24Fd, 0, M_LL_IRQ_COUNT ) == irqs + 11 );
+	UOS_Delay( 6 );
+	CHK( getStat( G_m24Fd, 0, M22_24_EVENT_COUNT ) == 12 );
+
+	/* quiet: irqs again */
+	UOS_Delay( 30 );
+	CHK( !getStat( G_m24Fd, 0, M22_24_POLL_ACTIVE ) );
+	SIM_InputSet( G_m24, 2, 1 );
+	CHK( getStat( G_m24Fd, 0, M_LL_IRQ_COUNT ) == irqs + 12 );
+	CHK( getStat( G_m24Fd, 0, M22_24_EVENT_COUNT ) == 13 );
+
+	SIM_InputSet( G_m24, 2, 0 );
+	CHK( !setStat( G_m24Fd, 0, M22_24_HYBRID_IRQ_RATE, 0 ) );
+	return( 0 );
+}
+
+/********************************* testPollMode *****************************
+ *
+ *  Description:  Polling mode without irqs. Edges reported in INTREG
+ *                mode are not reported again.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testPollMode( void )
+{
+	int32 irqs;
+
+	CHK( !setStat( G_m24Fd, 0, M22_24_POLL_PERIOD, 5 ) );
+	CHK( !setStat( G_m24Fd, 0, M22_24_EVENT_COUNT, 0 ) );
+	SIM_InputSet( G_m24, 3, 1 );
+	CHK( getStat( G_m24Fd, 0, M22_24_EVENT_COUNT ) == 1 );
+
+	CHK( !setStat( G_m24Fd, 0, M22_24_POLL_MODE, M22_24_POLL_MODE_POLL ) );
+	CHK( getStat( G_m24Fd, 0, M22_24_POLL_ACTIVE ) );
+	CHK( (G_m24->ioReg[3] & (REG_EN_RISING | REG_EN_FALLING)) == 0 );
+	irqs = getStat( G_m24Fd, 0, M_LL_IRQ_COUNT );
+
+	SIM_InputSet( G_m24, 3, 0 );
+	CHK( getStat( G_m24Fd, 0, M22_24_EVENT_COUNT ) == 1 );
+	UOS_Delay( 6 );
+	CHK( getStat( G_m24Fd, 0, M22_24_EVENT_COUNT ) == 2 );
+	CHK( getStat( G_m24Fd, 0, M_LL_IRQ_COUNT ) == irqs );
+
+	CHK( !setStat( G_m24Fd, 0, M22_24_POLL_MODE, M22_24_POLL_MODE_IRQ ) );
+	CHK( !getStat( G_m24Fd, 0, M22_24_POLL_ACTIVE ) );
+	CHK( G_m24->ioReg[3] & REG_EN_RISING );
+	return( 0 );
+}
+
+/********************************* testCachedRead ***************************
+ *
+ *  Description:  Reads from the irq image in scan mode only.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testCachedRead( void )
+{
+	int32 value;
+	u_int32 rd;
+
+	CHK( !setStat( G_m24Fd, 5, M22_24_CLEAR_INPUT_EDGE, 0 ) );
+	CHK( !setStat( G_m24Fd, 5, M22_24_CACHED_READ, 1 ) );
+
+	/* INTREG mode doesn't keep the image: registers are read */
+	CHK( getStat( G_m24Fd, 5, M22_24_IRQ_MODE ) == M22_24_IRQ_MODE_INTREG );
+	CHK( M_read( G_m24Fd, &value ) == 0 && value == 0 );
+	SIM_InputSet( G_m24, 5, 1 );
+	CHK( M_read( G_m24Fd, &value ) == 0 );
+	CHK( value == (M22_24_READ_INPUT | M22_24_READ_RISING_EDGE) );
+
+	/* scan mode: the irq updates the image */
+	CHK( !setStat( G_m24Fd, 5, M22_24_CLEAR_INPUT_EDGE, 0 ) );
+	CHK( !setStat( G_m24Fd, 5, M22_24_IRQ_MODE, M22_24_IRQ_MODE_SCAN ) );
+	CHK( M_read( G_m24Fd, &value ) == 0 && value == M22_24_READ_INPUT );
+	SIM_InputSet( G_m24, 5, 0 );
+	rd = G_m24->rdCount;
+	CHK( M_read( G_m24Fd, &value ) == 0 );
+	CHK( value == M22_24_READ_FALLING_EDGE );
+	CHK( G_m24->rdCount == rd );
+
+	CHK( !setStat( G_m24Fd, 5, M22_24_IRQ_MODE, M22_24_IRQ_MODE_INTREG ) );
+	CHK( !setStat( G_m24Fd, 5, M22_24_CACHED_READ, 0 ) );
+	CHK( !setStat( G_m24Fd, 5, M22_24_CLEAR_INPUT_EDGE, 0 ) );
+	return( 0 );
+}
+
+/********************************* testSubscribe ****************************
+ *
+ *  Description:  A subscriber gets its channels and edges only.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testSubscribe( void )
+{
+	M22_24_SUBSCRIBE sub;
+
+	sub.sigNo	 = UOS_SIG_USR2;
+	sub.chMask	 = 1 << 6;
+	sub.edgeMask = M22_24_SUB_RISING;
+	CHK( !setBlock( G_m24Fd, M22_24_SETBLOCK_SIG_SUBSCRIBE, &sub, sizeof(sub) ) );
+	CHK( getStat( G_m24Fd, 0, M22_24_SIG_SUBSCRIBERS ) == 1 );
+	G_sigCount = G_sig2Count = 0;
+
+	SIM_InputSet( G_m24, 6, 1 );
+	SIM_InputSet( G_m24, 6, 0 );
+	SIM_InputSet( G_m24, 5, 1 );
+	SIM_InputSet( G_m24, 5, 0 );
+	CHK( getStat( G_m24Fd, 0, M22_24_SIG_SUBSCRIBERS ) == 1 );
+	CHK( G_sig2Count == 1 );
+	CHK( G_sigCount == 4 );
+
+	CHK( !M_setstat( G_m24Fd, M22_24_SIG_UNSUBSCRIBE, UOS_SIG_USR2 ) );
+	CHK( getStat( G_m24Fd, 0, M22_24_SIG_SUBSCRIBERS ) == 0 );
+	SIM_InputSet( G_m24, 6, 1 );
+	SIM_InputSet( G_m24, 6, 0 );
+	CHK( getStat( G_m24Fd, 0, M22_24_SIG_SUBSCRIBERS ) == 0 );
+	CHK( G_sig2Count == 1 );
+	return( 0 );
+}
+
+/********************************* testCounters *****************************
+ *
+ *  Description:  Counter channels count edges instead of events, also
+ *                both edges of a pulse shorter than the irq latency.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testCounters( void )
+{
+	M22_24_COUNTER cnt[M24_MAX_CH];
+	OSS_IRQ_STATE state;
+	u_int32 i;
+
+	CHK( !setStat( G_m24Fd, 7, M22_24_COUNTER_MODE, 1 ) );
+	CHK( !setStat( G_m24Fd, 7, M22_24_EVENT_COUNT, 0 ) );
+	getBlock( G_m24Fd, M22_24_GETBLOCK_COUNTERS_CLR, cnt, sizeof(cnt) );
+
+	for( i = 0; i < 6; i++ )
+		SIM_InputSet( G_m24, 7, (i + 1) & 1 );
+
+	/* short pulse */
+	state = OSS_IrqMaskR( SIM_OssHandle(), NULL );
+	SIM_InputSet( G_m24, 7, 1 );
+	SIM_InputSet( G_m24, 7, 0 );
+	OSS_IrqRestore( SIM_OssHandle(), NULL, state );
+
+	CHK( getBlock( G_m24Fd, M22_24_GETBLOCK_COUNTERS_CLR, cnt, sizeof(cnt) ) ==
+		 (int32)sizeof(cnt) );
+	CHK( cnt[7].rising == 4 && cnt[7].falling == 4 );
+	CHK( cnt[6].rising == 0 );
+	CHK( getStat( G_m24Fd, 7, M22_24_EVENT_COUNT ) == 0 );
+
+	CHK( getBlock( G_m24Fd, M22_24_GETBLOCK_COUNTERS, cnt, sizeof(cnt) ) ==
+		 (int32)sizeof(cnt) );
+	CHK( cnt[7].rising == 0 && cnt[7].falling == 0 );
+
+	CHK( !setStat( G_m24Fd, 7, M22_24_COUNTER_MODE, 0 ) );
+	return( 0 );
+}
+
+/********************************* testMeas *********************************
+ *
+ *  Description:  Period and frequency of a 200Hz input.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testMeas( void )
+{
+	M22_24_MEAS meas[M24_MAX_CH];
+	u_int32 i;
+
+	CHK( !setStat( G_m24Fd, 11, M22_24_MEAS_GATE, 20 ) );
+	CHK( !setStat( G_m24Fd, 11, M22_24_MEAS_MODE, M22_24_MEAS_RISING ) );
+
+	/* 5ms period, 40 periods */
+	for( i = 0; i < 80; i++ )
+		CHK( !SIM_InputAt( G_m24, 1000 + i * 2500, 11, !(i & 1) ) );
+	UOS_Delay( 201 );
+
+	CHK( getBlock( G_m24Fd, M22_24_GETBLOCK_MEAS, meas, sizeof(meas) ) ==
+		 (int32)sizeof(meas) );
+	CHK( meas[11].gatePeriod == 5000 );
+	CHK( meas[11].gatePeriodMin == 5000 && meas[11].gatePeriodMax == 5000 );
+	CHK( meas[11].freq == 200000 );
+	CHK( meas[11].nbrGates >= 7 );
+	CHK( meas[10].nbrGates == 0 );
+	CHK( getStat( G_m24Fd, 11, M22_24_MEAS_PERIOD ) == 5000 );
+
+	CHK( !setStat( G_m24Fd, 11, M22_24_MEAS_MODE, M22_24_MEAS_OFF ) );
+	return( 0 );
+}
+
+/********************************* testDebounce *****************************
+ *
+ *  Description:  A glitch shorter than the debounce window isn't
+ *                reported, a bouncing level change once when it settled.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  G_sigCount
+ ****************************************************************************/
+static int testDebounce( void )
+{
+	M22_24_EVENT ev[8];
+	u_int32 sigs, t0;
+
+	CHK( !setStat( G_m24Fd, 10, M22_24_DEBOUNCE_US, 3 * TICK_MS * 1000 ) );
+	CHK( !setStat( G_m24Fd, 10, M22_24_EVENT_COUNT, 0 ) );
+	sigs = G_sigCount;
+
+	/* glitch */
+	SIM_InputSet( G_m24, 10, 1 );
+	CHK( (G_m24->ioReg[10] & (REG_EN_RISING | REG_EN_FALLING)) == 0 );
+	UOS_Delay( TICK_MS );
+	SIM_InputSet( G_m24, 10, 0 );
+	UOS_Delay( 30 * TICK_MS );
+	CHK( getStat( G_m24Fd, 10, M22_24_EVENT_COUNT ) == 0 );
+	CHK( G_sigCount == sigs );
+	CHK( G_m24->ioReg[10] & REG_EN_RISING );
+
+	/* bouncing, settles high: stable low until then */
+	t0 = OSS_TickGet( NULL );
+	SIM_InputSet( G_m24, 10, 1 );
+	SIM_InputSet( G_m24, 10, 0 );
+	SIM_InputSet( G_m24, 10, 1 );
+	UOS_Delay( TICK_MS );
+	SIM_InputSet( G_m24, 10, 0 );
+	SIM_InputSet( G_m24, 10, 1 );
+	CHK( !(getStat( G_m24Fd, 10, M22_24_PORT_INPUTS ) & (1 << 10)) );
+	CHK( getStat( G_m24Fd, 10, M22_24_EVENT_COUNT ) == 0 );
+	UOS_Delay( 30 * TICK_MS );
+	CHK( getStat( G_m24Fd, 10, M22_24_PORT_INPUTS ) & (1 << 10) );
+
+	/* bouncing, settles low */
+	SIM_InputSet( G_m24, 10, 0 );
+	SIM_InputSet( G_m24, 10, 1 );
+	SIM_InputSet( G_m24, 10, 0 );
+	UOS_Delay( 30 * TICK_MS );
+
+	CHK( getBlock( G_m24Fd, M22_24_GETBLOCK_EVENTS, ev, sizeof(ev) ) ==
+		 2 * (int32)sizeof(M22_24_EVENT) );
+	CHK( ev[0].flags == (M22_24_READ_INPUT | M22_24_READ_RISING_EDGE) );
+	CHK( ev[1].flags == M22_24_READ_FALLING_EDGE );
+	CHK( ev[0].timeStamp - t0 >= 1 );
+	CHK( G_sigCount == sigs + 2 );
+
+	/* rising edges only: glitch dropped, rise after an unseen fall */
+	CHK( !setStat( G_m24Fd, 10, M22_24_INPUT_EDGE_MASK,
+				   M22_24_RISING_EDGE_ENABLE ) );
+	SIM_InputSet( G_m24, 10, 1 );
+	UOS_Delay( 30 * TICK_MS );
+	SIM_InputSet( G_m24, 10, 0 );
+	UOS_Delay( 30 * TICK_MS );
+	SIM_InputSet( G_m24, 10, 1 );
+	SIM_InputSet( G_m24, 10, 0 );
+	UOS_Delay( 30 * TICK_MS );
+	SIM_InputSet( G_m24, 10, 1 );
+	UOS_Delay( 30 * TICK_MS );
+	CHK( getBlock( G_m24Fd, M22_24_GETBLOCK_EVENTS, ev, sizeof(ev) ) ==
+		 2 * (int32)sizeof(M22_24_EVENT) );
+	CHK( ev[0].flags == (M22_24_READ_INPUT | M22_24_READ_RISING_EDGE) );
+	CHK( ev[1].flags == (M22_24_READ_INPUT | M22_24_READ_RISING_EDGE) );
+
+	CHK( !setStat( G_m24Fd, 10, M22_24_DEBOUNCE_US, 0 ) );
+	CHK( !setStat( G_m24Fd, 10, M22_24_INPUT_EDGE_MASK,
+				   M22_24_RISING_EDGE_ENABLE | M22_24_FALLING_EDGE_ENABLE ) );
+	SIM_InputSet( G_m24, 10, 0 );
+	CHK( !setStat( G_m24Fd, 10, M22_24_EVENT_COUNT, 0 ) );
+	return( 0 );
+}
+
+/********************************* testSeq **********************************
+ *
+ *  Description:  Output sequencer steps, status and underruns of a late
+ *                timer, loop period without drift.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return 0 | 1
+ *  Globals....:  -
+ ****************************************************************************/
+static int testSeq( void )
+{
+	struct {
+		M22_SEQ			hdr;
+		M22_SEQ_STEP	step[4];
+	} seq;
+	M22_SEQ_STATUS st;
+	u_int32 i;
+
+	seq.hdr.flags	 = 0;
+	seq.hdr.period	 = 0;
+	seq.hdr.nbrSteps = 4;
+	for( i = 0; i < 4; i++ ){
+		seq.step[i].time = i * 2 * TICK_MS;
+		seq.step[i].mask = (i & 1) ? 0 : 0x01;
+	}
+
+	CHK( setBlock( G_m24Fd, M22_SETBLOCK_SEQ, &seq, sizeof(seq) ) );
+	CHK( !setBlock( G_m22Fd, M22_SETBLOCK_SEQ, &seq, sizeof(seq) ) );
+	CHK( G_m22->ioReg[0] & REG_OUTPUT );
+	UOS_Delay( 3 * TICK_MS );
+	CHK( !(G_m22->ioReg[0] & REG_OUTPUT) );
+	CHK( getBlock( G_m22Fd, M22_GETBLOCK_SEQ_STATUS, &st, sizeof(st) ) ==
+		 (int32)sizeof(st) );
+	CHK( st.state == M22_SEQ_RUNNING && st.step == 2 && st.nbrSteps == 4 );
+	CHK( st.underruns == 0 );
+
+	/* timer late: steps 2 and 3 are both output late */
+	SIM_Stall( 4000 * TICK_MS );
+	UOS_Delay( TICK_MS );
+	CHK( getBlock( G_m22Fd, M22_GETBLOCK_SEQ_STATUS, &st, sizeof(st) ) ==
+		 (int32)sizeof(st) );
+	CHK( st.state == M22_SEQ_DONE && st.step == 4 );
+	CHK( st.underruns == 2 );
+	CHK( !(G_m22->ioReg[0] & REG_OUTPUT) );
+
+	/* 10ms loop: 100 loops per second, steps sharing a tick aren't late */
+	seq.hdr.flags	 = M22_SEQ_LOOP;
+	seq.hdr.period	 = 10;
+	seq.hdr.nbrSteps = 3;
+	seq.step[1].time = 5;
+	seq.step[2].time = 6;
+	seq.step[2].mask = 0;
+	CHK( !setBlock( G_m22Fd, M22_SETBLOCK_SEQ, &seq, sizeof(seq) ) );
+	UOS_Delay( 1000 );
+	CHK( getBlock( G_m22Fd, M22_GETBLOCK_SEQ_STATUS, &st, sizeof(st) ) ==
+		 (int32)sizeof(st) );
+	CHK( st.state == M22_SEQ_RUNNING );
+	CHK( st.loops >= 99 && st.loops <= 100 );
+	CHK( st.underruns == 0 );
+	CHK( setStat( G_m22Fd, 0, M22_SEQ_STOP, 0 ) == 0 );
+
+	seq.hdr.nbrSteps = 0;
+	CHK( !setBlock( G_m22Fd, M22_SETBLOCK_SEQ, &seq, sizeof(seq) ) );
+	return( 0 );
+}
+
+/********************************* bench ************************************
+ *
+ *  Description:  Time the hot paths with the host clock.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  loops   number of calls
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+static void bench( u_int32 loops )
+{
+	M22_24_IRQ_STATS st;
+	u_int8 buf[M24_MAX_CH];
+	u_int32 i, t, rd, wr;
+
+	printf( "\nbenchmark, %u loops, host time [ns/call], register accesses\n",
+			(unsigned)loops );
+	setStat( G_m24Fd, 0, M22_24_SIG_CLR_EDGE_OCCURRED, 0 );
+
+	/* M22_Irq: one edge per irq */
+	for( i = 0; i < 2; i++ ){
+		setStat( G_m24Fd, 0, M22_24_IRQ_MODE, i );
+		setStat( G_m24Fd, 0, M22_24_IRQ_STATS_CLEAR, 0 );
+		rd = G_m24->rdCount;
+		wr = G_m24->wrCount;
+		for( t = 0; t < loops; t++ )
+			SIM_InputSet( G_m24, t % M24_MAX_CH, (t / M24_MAX_CH) & 1 );
+		getBlock( G_m24Fd, M22_24_GETBLOCK_IRQ_STATS, &st, sizeof(st) );
+		printf( "M22_Irq %-6s        %8u avg %8u max   %5.1f rd %5.1f wr\n",
+				i ? "scan" : "intreg", (unsigned)st.timeAvg,
+				(unsigned)st.timeMax, (double)(G_m24->rdCount - rd) / loops,
+				(double)(G_m24->wrCount - wr) / loops );
+	}
+	setStat( G_m24Fd, 0, M22_24_IRQ_MODE, M22_24_IRQ_MODE_INTREG );
+
+	/* M22_BlockRead */
+	rd = G_m24->rdCount;
+	t = SIM_CycleGet();
+	for( i = 0; i < loops; i++ )
+		M_getblock( G_m24Fd, buf, sizeof(buf) );
+	t = SIM_CycleGet() - t;
+	printf( "M_getblock 16 ch      %8u             %5.1f rd\n",
+			(unsigned)(t / loops), (double)(G_m24->rdCount - rd) / loops );
+
+	/* configureIrqForChannel through the edge mask setstat */
+	rd = G_m24->rdCount;
+	wr = G_m24->wrCount;
+	t = SIM_CycleGet();
+	for( i = 0; i < loops; i++ )
+		setStat( G_m24Fd, i % M24_MAX_CH, M22_24_INPUT_EDGE_MASK,
+				 (i & M24_MAX_CH) ? 1 : 3 );
+	t = SIM_CycleGet() - t;
+	printf( "INPUT_EDGE_MASK       %8u             %5.1f rd %5.1f wr\n",
+			(unsigned)(t / loops), (double)(G_m24->rdCount - rd) / loops,
+			(double)(G_m24->wrCount - wr) / loops );
+}
+
+/********************************* sigHandler *******************************
+ *
+ *  Description:  Count the edge signals.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  sigNo  signal number
+ *  Output.....:  -
+ *  Globals....:  G_sigCount, G_sig2Count
+ ****************************************************************************/
+static void sigHandler( u_int32 sigNo )
+{
+	if( sigNo == UOS_SIG_USR1 )
+		G_sigCount++;
+	else if( sigNo == UOS_SIG_USR2 )
+		G_sig2Count++;
+}
+
+/********************************* getBlock *********************************
+ *
+ *  Description:  Block getstat.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  fd, code, data, size
+ *  Output.....:  return size read | -1
+ *  Globals....:  -
+ ****************************************************************************/
+static int32 getBlock( int32 fd, int32 code, void *data, int32 size )
+{
+	M_SETGETSTAT_BLOCK blk;
+
+	blk.size = size;
+	blk.data = data;
+	if( M_getstat( fd, code, (int32*)&blk ) )
+		return( -1 );
+	return( blk.size );
+}
+
+/********************************* setBlock *********************************
+ *
+ *  Description:  Block setstat.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  fd, code, data, size
+ *  Output.....:  return 0 | -1
+ *  Globals....:  -
+ ****************************************************************************/
+static int32 setBlock( int32 fd, int32 code, void *data, int32 size )
+{
+	M_SETGETSTAT_BLOCK blk;
+
+	blk.size = size;
+	blk.data = data;
+	return( M_setstat( fd, code, (INT32_OR_64)&blk ) );
+}
+
+/********************************* getStat **********************************
+ *
+ *  Description:  Getstat of a channel.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  fd, ch, code
+ *  Output.....:  return value | -1
+ *  Globals....:  -
+ ****************************************************************************/
+static int32 getStat( int32 fd, int32 ch, int32 code )
+{
+	int32 value = 0;
+
+	if( M_setstat( fd, M_MK_CH_CURRENT, ch ) ||
+		M_getstat( fd, code, &value ) )
+		return( -1 );
+	return( value );
+}
+
+/********************************* setStat **********************************
+ *
+ *  Description:  Setstat of a channel.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  fd, ch, code, value
+ *  Output.....:  return 0 | -1
+ *  Globals....:  -
+ ****************************************************************************/
+static int32 setStat( int32 fd, int32 ch, int32 code, int32 value )
+{
+	if( M_setstat( fd, M_MK_CH_CURRENT, ch ) )
+		return( -1 );
+	return( M_setstat( fd, code, value ) );
+}
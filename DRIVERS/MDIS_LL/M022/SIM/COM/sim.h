@@ -0,0 +1,149 @@
+/***********************  I n c l u d e  -  F i l e  ************************
+ *
+ *         Name: sim.h
+ *
+ *  Description: Register-level M22/M24 simulator for host builds
+ *
+ *               The unmodified m22_drv.c is compiled for the host together
+ *               with stub OSS, DESC, MDIS kernel and USR_OSS layers. All
+ *               register accesses are routed to a model of the M-Module:
+ *
+ *               - i/o registers with output switch, irq enables, input
+ *                 value and latched edge flags (write 0 clears an edge flag,
+ *                 write 1 keeps it)
+ *               - M22 alarm registers
+ *               - INTREG reporting only one of the pending channels and
+ *                 clearing all of them, like the real module
+ *               - ID EEPROM served through m_read()
+ *               - optional loopback M22 output ch -> M24 input ch and ch+8
+ *
+ *               Time is simulated: OSS alarms, scheduled input stimuli and
+ *               semaphore timeouts only advance with SIM_Advance(),
+ *               UOS_Delay(), UOS_MikroDelay() or a waiting OSS_SemWait().
+ *               SIM_Stall() moves the time on without running events, so
+ *               the due alarms run late.
+ *               The tick rate is 1000 Hz. The irq line is checked after
+ *               every register write, stimulus and OSS_IrqRestore() and the
+ *               driver's M22_Irq() is called at once when it is unmasked.
+ *               Signals are queued and delivered to the UOS_SigInit()
+ *               handler outside of driver calls.
+ *
+ *               Devices are created with SIM_DevCreate() or implicitly by
+ *               M_open(): names starting with "m24" are M24 modules, all
+ *               others M22. The descriptor of an implicit device is read
+ *               from the environment variable M22SIM_<NAME> (upper case),
+ *               e.g. M22SIM_M22_1="IRQ_MODE=1;CHANNEL_3/INACTIVE=1".
+ *               M22SIM_STIM_<NAME>="<ch>,<usec>,<edges>" toggles an input
+ *               of an implicit device every usec after the open.
+ *               The first M22 and M24 device are looped back unless
+ *               M22SIM_LOOPBACK=0. The M24 channels ch+8 follow 1us later
+ *               (M22SIM_LOOP_SKEW_US), so the test adapter edges of ch and
+ *               ch+8 get separate irqs; with 0 they are simultaneous and
+ *               INTREG reports only one of them.
+ *
+ *     Switches: -
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _SIM_H
+#define _SIM_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*-----------------------------------------+
+|  DEFINES                                 |
++------------------------------------------*/
+#define SIM_MAX_CH			16		/* M24 */
+#define SIM_MAX_ALARM		8		/* M22 */
+#ifndef SIM_TICK_RATE
+# define SIM_TICK_RATE		1000	/* OSS ticks per second (make SIM_HZ=) */
+#endif
+#define SIM_FOREVER			((u_int64)-1)	/* SIM_RunUntil() deadline */
+
+/*-----------------------------------------+
+|  TYPEDEFS                                |
++------------------------------------------*/
+/* M-Module model, also the MACCESS handle of the driver */
+typedef struct SIM_MOD {
+	u_int32			modId;				/* 22 or 24 */
+	u_int32			nbrCh;				/* 8 or 16 */
+	u_int8			ioReg[SIM_MAX_CH];	/* output switch + irq enables */
+	u_int8			ext[SIM_MAX_CH];	/* external input level */
+	u_int8			level[SIM_MAX_CH];	/* resulting input value */
+	u_int8			edges[SIM_MAX_CH];	/* latched edge flags */
+	u_int8			pend[SIM_MAX_CH];	/* irq pending */
+	u_int8			almReg[SIM_MAX_ALARM];
+	u_int8			almLevel[SIM_MAX_ALARM];
+	u_int8			almEdges[SIM_MAX_ALARM];
+	u_int8			almPend[SIM_MAX_ALARM];
+	u_int16			eeprom[64];			/* ID EEPROM words */
+	struct SIM_MOD	*loop;				/* M24 fed by the M22 outputs */
+	u_int32			loopSkew;			/* delay of M24 ch+8 [us] */
+	/* statistics */
+	u_int32			rdCount;			/* register reads */
+	u_int32			wrCount;			/* register writes */
+	u_int32			edgeCount;			/* edges latched */
+	u_int32			irqRaised;			/* enabled edges raising the line */
+	u_int32			irqLost;			/* pending irqs lost in INTREG */
+	u_int32			edgeSetWr;			/* 1 written to a clear edge flag */
+} SIM_MOD;
+
+/*-----------------------------------------+
+|  PROTOTYPES                              |
++------------------------------------------*/
+/* module model (sim_hw.c) */
+extern void SIM_ModInit( SIM_MOD *mod, u_int32 modId );
+extern void SIM_Loopback( SIM_MOD *m22, SIM_MOD *m24, u_int32 skewUs );
+extern void SIM_InputSet( SIM_MOD *mod, u_int32 ch, u_int32 level );
+extern void SIM_AlarmSet( SIM_MOD *mod, u_int32 ch, u_int32 level );
+extern int32 SIM_IrqLine( SIM_MOD *mod );
+
+/* time, stimuli and interrupts (sim_oss.c) */
+extern u_int64 SIM_TimeUs( void );
+extern void SIM_Advance( u_int32 usec );
+extern void SIM_Stall( u_int32 usec );
+extern int32 SIM_InputAt( SIM_MOD *mod, u_int32 usec, u_int32 ch,
+						  u_int32 level );
+extern void SIM_IrqCheck( void );
+extern void SIM_PostEventHook( void (*hook)(void) );
+
+/* kernel side of sim_oss.c, used by sim_mdis.c */
+extern struct OSS_HANDLE *SIM_OssHandle( void );
+extern struct OSS_IRQ_HANDLE *SIM_IrqCreate( SIM_MOD *mod,
+											 int32 (*isr)(void *arg),
+											 void *arg );
+extern void SIM_IrqEnable( struct OSS_IRQ_HANDLE *irqHdl, int32 enable );
+extern void SIM_IrqRemove( struct OSS_IRQ_HANDLE **irqHdlP );
+extern int32 SIM_RunUntil( u_int64 deadline, int32 (*cond)(void *arg),
+						   void *arg );
+extern int32 SIM_SigGet( u_int32 *sigNoP );
+extern int32 SIM_MemBlocks( void );
+
+/* devices (sim_mdis.c) */
+extern SIM_MOD *SIM_DevCreate( const char *name, u_int32 modId,
+							   const char *desc );
+extern SIM_MOD *SIM_DevModule( const char *name );
+extern void SIM_DevRemove( const char *name );
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif /* _SIM_H */
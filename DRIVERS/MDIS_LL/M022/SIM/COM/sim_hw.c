@@ -0,0 +1,374 @@
+/*********************  P r o g r a m  -  M o d u l e ***********************
+ *
+ *         Name: sim_hw.c
+ *
+ *  Description: M22/M24 register model of the host simulator
+ *
+ *               Models the register interface seen by m22_drv.c:
+ *
+ *               IOREG(ch)     0x00..0x1e  output switch, irq enables,
+ *                                         input value, edge flags
+ *               ALARMREG(ch)  0x10..0x1e  alarm irq enables, value, edge
+ *                                         flags (M22 only)
+ *               INTREG        0xfe        source of the irq, read clears
+ *                                         all pending irqs
+ *
+ *               Edge flags are latched independent of the irq enables.
+ *               A pending irq is set when an enabled edge is latched.
+ *               The M22 input value is the output switch or'ed with the
+ *               external level.
+ *
+ *     Required: -
+ *     Switches: -
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+
+#include <MEN/men_typs.h>
+#include <MEN/maccess.h>
+#include <MEN/modcom.h>
+
+#include "sim.h"
+
+/*-----------------------------------------+
+|  DEFINES                                 |
++------------------------------------------*/
+#define ALARM_OFFS		0x10
+#define INTREG			0xfe
+
+#define REG_OUTPUT		0x01	/* output switch */
+#define REG_EN_RISING	0x02	/* rising edge irq enable */
+#define REG_EN_FALLING	0x04	/* falling edge irq enable */
+#define REG_VALUE		0x08	/* input or alarm value */
+#define REG_RISING		0x10	/* rising edge occurred */
+#define REG_FALLING		0x20	/* falling edge occurred */
+#define REG_EDGES		(REG_RISING | REG_FALLING)
+
+#define M22_INT_ALARM	0x10	/* INTREG: source is an alarm register */
+
+#define ID_MAGIC		0x5346
+
+/*-----------------------------------------+
+|  PROTOTYPES                              |
++------------------------------------------*/
+static void latchEdge( SIM_MOD *mod, u_int8 *levelP, u_int8 *edgesP,
+					   u_int8 *pendP, u_int8 reg, u_int32 level );
+static void levelUpdate( SIM_MOD *mod, u_int32 ch );
+
+/********************************* SIM_ModInit ******************************
+ *
+ *  Description:  Initialize the model of an M22 or M24 after power up.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  mod    module model
+ *                modId  22 or 24
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+void SIM_ModInit( SIM_MOD *mod, u_int32 modId )
+{
+	memset( mod, 0, sizeof(*mod) );
+	mod->modId = modId;
+	mod->nbrCh = modId == 24 ? 16 : 8;
+
+	mod->eeprom[0] = ID_MAGIC;
+	mod->eeprom[1] = (u_int16)modId;
+	mod->eeprom[2] = 1;		/* revision */
+	mod->eeprom[3] = 1;		/* serial number */
+}
+
+/********************************* SIM_Loopback *****************************
+ *
+ *  Description:  Wire the M22 outputs to the M24 inputs.
+ *
+ *                M22 output ch drives M24 input ch and, delayed by the
+ *                skew, ch+8. Pass NULL as m24 to disconnect.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  m22    M22 model
+ *                m24    M24 model or NULL
+ *                skewUs delay of the M24 channels ch+8 [us]
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+void SIM_Loopback( SIM_MOD *m22, SIM_MOD *m24, u_int32 skewUs )
+{
+	u_int32 ch;
+
+	m22->loop     = m24;
+	m22->loopSkew = skewUs;
+	if( m24 == NULL )
+		return;
+
+	for( ch = 0; ch < m22->nbrCh; ch++ ){
+		SIM_InputSet( m24, ch, m22->ioReg[ch] & REG_OUTPUT );
+		SIM_InputSet( m24, ch + 8, m22->ioReg[ch] & REG_OUTPUT );
+	}
+}
+
+/********************************* SIM_InputSet *****************************
+ *
+ *  Description:  Drive the external level of an input.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  mod    module model
+ *                ch     channel
+ *                level  0 or !=0
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+void SIM_InputSet( SIM_MOD *mod, u_int32 ch, u_int32 level )
+{
+	if( ch >= mod->nbrCh )
+		return;
+
+	mod->ext[ch] = level ? 1 : 0;
+	levelUpdate( mod, ch );
+	SIM_IrqCheck();
+}
+
+/********************************* SIM_AlarmSet *****************************
+ *
+ *  Description:  Drive the alarm value of an M22 output.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  mod    module model
+ *                ch     channel
+ *                level  0 or !=0
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+void SIM_AlarmSet( SIM_MOD *mod, u_int32 ch, u_int32 level )
+{
+	if( mod->modId != 22 || ch >= SIM_MAX_ALARM )
+		return;
+
+	latchEdge( mod, &mod->almLevel[ch], &mod->almEdges[ch], &mod->almPend[ch],
+			   mod->almReg[ch], level );
+	SIM_IrqCheck();
+}
+
+/********************************* SIM_IrqLine ******************************
+ *
+ *  Description:  Get the state of the irq line.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  mod    module model
+ *  Output.....:  return 1 if an irq is pending
+ *  Globals....:  -
+ ****************************************************************************/
+int32 SIM_IrqLine( SIM_MOD *mod )
+{
+	u_int32 ch;
+
+	for( ch = 0; ch < mod->nbrCh; ch++ )
+		if( mod->pend[ch] )
+			return( 1 );
+	for( ch = 0; ch < SIM_MAX_ALARM; ch++ )
+		if( mod->almPend[ch] )
+			return( 1 );
+
+	return( 0 );
+}
+
+/********************************* SIM_Read16 *******************************
+ *
+ *  Description:  Register read access.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  ma     module model
+ *                offs   register offset
+ *  Output.....:  return register value
+ *  Globals....:  -
+ ****************************************************************************/
+u_int16 SIM_Read16( MACCESS ma, u_int32 offs )
+{
+	SIM_MOD *mod = ma;
+	u_int32 ch = offs >> 1;
+	u_int32 n = 0, i;
+	u_int16 val = 0;
+
+	mod->rdCount++;
+
+	if( offs == INTREG ){
+		/* report the lowest source (i/o before alarm), clear all */
+		for( i = SIM_MAX_ALARM; i-- > 0; ){
+			if( mod->almPend[i] ){
+				val = (u_int16)((i << 1) | M22_INT_ALARM);
+				mod->almPend[i] = 0;
+				n++;
+			}
+		}
+		for( i = mod->nbrCh; i-- > 0; ){
+			if( mod->pend[i] ){
+				val = (u_int16)(i << 1);
+				mod->pend[i] = 0;
+				n++;
+			}
+		}
+		if( n > 1 )
+			mod->irqLost += n - 1;
+		return( val );
+	}
+
+	if( ch < mod->nbrCh ){
+		return( (u_int16)(mod->ioReg[ch] | mod->edges[ch] |
+						  (mod->level[ch] ? REG_VALUE : 0)) );
+	}
+
+	if( mod->modId == 22 && offs >= ALARM_OFFS && offs < ALARM_OFFS + 0x10 ){
+		ch = (offs - ALARM_OFFS) >> 1;
+		return( (u_int16)(mod->almReg[ch] | mod->almEdges[ch] |
+						  (mod->almLevel[ch] ? REG_VALUE : 0)) );
+	}
+
+	return( 0xffff );
+}
+
+/********************************* SIM_Write16 ******************************
+ *
+ *  Description:  Register write access.
+ *
+ *                Edge flags written as 0 are cleared, written as 1 kept.
+ *                Writing 1 to a clear edge flag is counted in edgeSetWr:
+ *                the driver must only write back flags it has read.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  ma     module model
+ *                offs   register offset
+ *                val    value
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+void SIM_Write16( MACCESS ma, u_int32 offs, u_int16 val )
+{
+	SIM_MOD *mod = ma;
+	u_int32 ch = offs >> 1;
+	u_int8 out;
+
+	mod->wrCount++;
+
+	if( ch < mod->nbrCh ){
+		if( val & REG_EDGES & ~mod->edges[ch] )
+			mod->edgeSetWr++;
+		if( mod->modId == 22 ){
+			out = mod->ioReg[ch] & REG_OUTPUT;
+			mod->ioReg[ch] = (u_int8)(val & (REG_OUTPUT | REG_EN_RISING |
+											 REG_EN_FALLING));
+			mod->edges[ch] &= (u_int8)val;
+			levelUpdate( mod, ch );
+
+			if( mod->loop && out != (mod->ioReg[ch] & REG_OUTPUT) ){
+				out = mod->ioReg[ch] & REG_OUTPUT;
+				mod->loop->ext[ch] = out;
+				levelUpdate( mod->loop, ch );
+				if( mod->loopSkew )
+					SIM_InputAt( mod->loop, mod->loopSkew, ch + 8, out );
+				else {
+					mod->loop->ext[ch + 8] = out;
+					levelUpdate( mod->loop, ch + 8 );
+				}
+			}
+		}
+		else {
+			mod->ioReg[ch] = (u_int8)(val & (REG_EN_RISING | REG_EN_FALLING));
+			mod->edges[ch] &= (u_int8)val;
+		}
+	}
+	else if( mod->modId == 22 && offs >= ALARM_OFFS &&
+			 offs < ALARM_OFFS + 0x10 ){
+		ch = (offs - ALARM_OFFS) >> 1;
+		if( val & REG_EDGES & ~mod->almEdges[ch] )
+			mod->edgeSetWr++;
+		mod->almReg[ch] = (u_int8)(val & (REG_EN_RISING | REG_EN_FALLING));
+		mod->almEdges[ch] &= (u_int8)val;
+	}
+
+	SIM_IrqCheck();
+}
+
+/********************************* m_read ***********************************
+ *
+ *  Description:  Read a word of the ID EEPROM.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  base   module model
+ *                index  word index
+ *  Output.....:  return word
+ *  Globals....:  -
+ ****************************************************************************/
+int m_read( U_INT32_OR_64 base, int8 index )
+{
+	SIM_MOD *mod = (SIM_MOD*)base;
+
+	return( mod->eeprom[index & 0x3f] );
+}
+
+/********************************* latchEdge ********************************
+ *
+ *  Description:  Apply a new level, latch the edge and raise the irq.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  mod     module model
+ *                levelP  current level
+ *                edgesP  edge flags
+ *                pendP   irq pending flag
+ *                reg     irq enables
+ *                level   new level
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+static void latchEdge( SIM_MOD *mod, u_int8 *levelP, u_int8 *edgesP,
+					   u_int8 *pendP, u_int8 reg, u_int32 level )
+{
+	level = level ? 1 : 0;
+	if( *levelP == level )
+		return;
+
+	*levelP = (u_int8)level;
+	*edgesP |= level ? REG_RISING : REG_FALLING;
+	mod->edgeCount++;
+
+	if( reg & (level ? REG_EN_RISING : REG_EN_FALLING) ){
+		*pendP = 1;
+		mod->irqRaised++;
+	}
+}
+
+/********************************* levelUpdate ******************************
+ *
+ *  Description:  Recalculate the input value of a channel.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  mod    module model
+ *                ch     channel
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+static void levelUpdate( SIM_MOD *mod, u_int32 ch )
+{
+	u_int32 level = mod->ext[ch];
+
+	if( mod->modId == 22 )
+		level |= mod->ioReg[ch] & REG_OUTPUT;
+
+	latchEdge( mod, &mod->level[ch], &mod->edges[ch], &mod->pend[ch],
+			   mod->ioReg[ch], level );
+}
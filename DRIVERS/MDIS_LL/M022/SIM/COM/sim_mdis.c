@@ -0,0 +1,858 @@
+/*********************  P r o g r a m  -  M o d u l e ***********************
+ *
+ *         Name: sim_mdis.c
+ *
+ *  Description: MDIS kernel and USR_OSS layer of the host simulator
+ *
+ *               Implements the MDIS user API on top of the M22 low-level
+ *               driver entries and the USR_OSS functions used by the M22
+ *               tools:
+ *
+ *               - the first M_open() of a device initializes the driver,
+ *                 the last M_close() removes it; the module model keeps
+ *                 its state like the real hardware
+ *               - each path has its own current channel
+ *               - the device semaphore is taken around each driver call
+ *                 (LL_LOCK_CALL)
+ *               - the kernel codes M_MK_CH_CURRENT, M_MK_IRQ_ENABLE,
+ *                 M_MK_IO_MODE and M_MK_BLK_REV_ID are handled here, the
+ *                 descriptor key IRQ_ENABLE enables the irq at open
+ *               - queued signals are delivered after each API call and
+ *                 after each time line event of UOS_Delay()
+ *
+ *     Required: -
+ *     Switches: -
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+
+#include <MEN/men_typs.h>
+#include <MEN/maccess.h>
+#include <MEN/oss.h>
+#include <MEN/desc.h>
+#include <MEN/mdis_api.h>
+#include <MEN/mdis_com.h>
+#include <MEN/mdis_err.h>
+#include <MEN/ll_defs.h>
+#include <MEN/ll_entry.h>
+#include <MEN/usr_oss.h>
+
+#include "sim.h"
+
+/*-----------------------------------------+
+|  DEFINES                                 |
++------------------------------------------*/
+#define MAX_PATHS		32
+#define MAX_SIGNALS		32
+#define DEV_NAME_SIZE	32
+
+/*-----------------------------------------+
+|  TYPEDEFS                                |
++------------------------------------------*/
+typedef struct SIM_DEV {
+	char			name[DEV_NAME_SIZE];
+	SIM_MOD			mod;
+	char			*desc;
+	LL_ENTRY		entry;
+	LL_HANDLE		*llHdl;
+	OSS_IRQ_HANDLE	*irqHdl;
+	OSS_SEM_HANDLE	*devSem;
+	u_int32			useIrq;
+	int32			irqEnabled;
+	int32			nbrCh;
+	int32			openCnt;
+	struct SIM_DEV	*next;
+} SIM_DEV;
+
+typedef struct {
+	SIM_DEV			*dev;
+	int32			ch;
+	int32			ioMode;
+} PATH;
+
+/*-----------------------------------------+
+|  EXTERNALS                               |
++------------------------------------------*/
+extern void M22_GetEntry( LL_ENTRY *drvP );
+
+/*-----------------------------------------+
+|  STATICS                                 |
++------------------------------------------*/
+static SIM_DEV	*G_devList;
+static PATH		G_path[MAX_PATHS];
+static int32	G_inDriver;
+static int32	G_sigMasked;
+static int32	G_delivering;
+static void		(*G_sigHandler)( u_int32 sigCode );
+static u_int8	G_sigInstalled[MAX_SIGNALS];
+
+static const struct {
+	int32		code;
+	const char	*str;
+} G_errTbl[] = {
+	{ ERR_MK_ILL_PARAM,		 "illegal parameter" },
+	{ ERR_MK_UNK_CODE,		 "unknown status code" },
+	{ ERR_MK_NO_LLDRV,		 "no low-level driver" },
+	{ ERR_MK_USERBUF,		 "user buffer too small" },
+	{ ERR_MK_ILL_PATH,		 "illegal path" },
+	{ ERR_OSS_MEM_ALLOC,	 "can't allocate memory" },
+	{ ERR_OSS_SIG_SET,		 "can't install signal" },
+	{ ERR_OSS_TIMEOUT,		 "timeout" },
+	{ ERR_OSS_SIG_OCCURED,	 "signal occurred" },
+	{ ERR_OSS_BUSY_RESOURCE, "resource busy" },
+	{ ERR_OSS_ILL_PARAM,	 "illegal parameter" },
+	{ ERR_LL_ILL_ID,		 "illegal module id" },
+	{ ERR_LL_DESC_PARAM,	 "illegal descriptor parameter" },
+	{ ERR_LL_ILL_CHAN,		 "illegal channel" },
+	{ ERR_LL_ILL_PARAM,		 "illegal parameter" },
+	{ ERR_LL_UNK_CODE,		 "unknown status code" },
+	{ ERR_LL_USERBUF,		 "user buffer too small" },
+	{ ERR_LL_READ,			 "read error" },
+	{ ERR_LL_WRITE,			 "write error" },
+	{ ERR_LL_ILL_FUNC,		 "illegal function" },
+	{ ERR_DESC_KEY_NOTFOUND, "descriptor key not found" },
+	{ 0, NULL }
+};
+
+/*-----------------------------------------+
+|  PROTOTYPES                              |
++------------------------------------------*/
+static SIM_DEV *devFind( const char *name );
+static void loopbackCheck( void );
+static void stimCheck( SIM_DEV *dev );
+static int32 devIsr( void *arg );
+static int32 devInit( SIM_DEV *dev );
+static void devExit( SIM_DEV *dev );
+static PATH *pathGet( int32 path );
+static void callEnter( SIM_DEV *dev );
+static int32 callExit( SIM_DEV *dev, int32 error );
+static void sigDeliver( void );
+static int32 revIdGet( PATH *p, M_SETGETSTAT_BLOCK *blk );
+
+/********************************* SIM_DevCreate ****************************
+ *
+ *  Description:  Create a simulated device.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  name   device name
+ *                modId  22 or 24
+ *                desc   descriptor text or NULL
+ *  Output.....:  return module model or NULL
+ *  Globals....:  G_devList
+ ****************************************************************************/
+SIM_MOD *SIM_DevCreate( const char *name, u_int32 modId, const char *desc )
+{
+	SIM_DEV *dev, **pp;
+
+	if( devFind( name ) )
+		return( NULL );
+
+	dev = calloc( 1, sizeof(*dev) );
+	if( dev == NULL || (dev->desc = strdup( desc ? desc : "" )) == NULL ){
+		free( dev );
+		return( NULL );
+	}
+
+	snprintf( dev->name, sizeof(dev->name), "%s", name );
+	SIM_ModInit( &dev->mod, modId );
+
+	/* append, first created devices are looped back */
+	for( pp = &G_devList; *pp; pp = &(*pp)->next )
+		;
+	*pp = dev;
+	loopbackCheck();
+
+	return( &dev->mod );
+}
+
+/********************************* SIM_DevModule ****************************
+ *
+ *  Description:  Get the module model of a device.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  name   device name
+ *  Output.....:  return module model or NULL
+ *  Globals....:  -
+ ****************************************************************************/
+SIM_MOD *SIM_DevModule( const char *name )
+{
+	SIM_DEV *dev = devFind( name );
+
+	return( dev ? &dev->mod : NULL );
+}
+
+/********************************* SIM_DevRemove ****************************
+ *
+ *  Description:  Remove a closed device.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  name   device name
+ *  Output.....:  -
+ *  Globals....:  G_devList
+ ****************************************************************************/
+void SIM_DevRemove( const char *name )
+{
+	SIM_DEV **pp, *dev, *d;
+
+	for( pp = &G_devList; (dev = *pp) != NULL; pp = &dev->next ){
+		if( !strcmp( dev->name, name ) && dev->openCnt == 0 ){
+			*pp = dev->next;
+			for( d = G_devList; d; d = d->next )
+				if( d->mod.loop == &dev->mod )
+					d->mod.loop = NULL;
+			free( dev->desc );
+			free( dev );
+			return;
+		}
+	}
+}
+
+/*-----------------------------------------+
+|  MDIS API                                |
++------------------------------------------*/
+int32 M_open( const char *device )
+{
+	char env[DEV_NAME_SIZE + 8];
+	SIM_DEV *dev;
+	int32 path, error, i;
+
+	for( path = 0; path < MAX_PATHS && G_path[path].dev; path++ )
+		;
+	if( path == MAX_PATHS ){
+		errno = ERR_MK_ILL_PATH;
+		return( -1 );
+	}
+
+	/* implicit device, descriptor from the environment */
+	if( (dev = devFind( device )) == NULL ){
+		i = snprintf( env, sizeof(env), "M22SIM_%s", device );
+		while( --i >= 0 )
+			env[i] = (char)toupper( (unsigned char)env[i] );
+		SIM_DevCreate( device, strncasecmp( device, "m24", 3 ) ? 22 : 24,
+					   getenv( env ) );
+		if( (dev = devFind( device )) == NULL ){
+			errno = ERR_OSS_MEM_ALLOC;
+			return( -1 );
+		}
+		stimCheck( dev );
+	}
+
+	if( dev->openCnt == 0 && (error = devInit( dev )) != 0 ){
+		errno = error;
+		return( -1 );
+	}
+
+	dev->openCnt++;
+	G_path[path].dev    = dev;
+	G_path[path].ch     = 0;
+	G_path[path].ioMode = M_IO_EXEC;
+	sigDeliver();
+
+	return( path );
+}
+
+int32 M_close( int32 path )
+{
+	PATH *p = pathGet( path );
+
+	if( p == NULL )
+		return( -1 );
+
+	if( --p->dev->openCnt == 0 )
+		devExit( p->dev );
+	p->dev = NULL;
+	sigDeliver();
+
+	return( 0 );
+}
+
+int32 M_read( int32 path, int32 *valueP )
+{
+	PATH *p = pathGet( path );
+
+	if( p == NULL )
+		return( -1 );
+
+	callEnter( p->dev );
+	return( callExit( p->dev,
+					  p->dev->entry.read( p->dev->llHdl, p->ch, valueP ) ) );
+}
+
+int32 M_write( int32 path, int32 value )
+{
+	PATH *p = pathGet( path );
+
+	if( p == NULL )
+		return( -1 );
+
+	callEnter( p->dev );
+	return( callExit( p->dev,
+					  p->dev->entry.write( p->dev->llHdl, p->ch, value ) ) );
+}
+
+int32 M_getblock( int32 path, u_int8 *buffer, int32 length )
+{
+	PATH *p = pathGet( path );
+	int32 n = 0, error;
+
+	if( p == NULL )
+		return( -1 );
+
+	callEnter( p->dev );
+	error = p->dev->entry.blockRead( p->dev->llHdl, p->ch, buffer, length, &n );
+	return( callExit( p->dev, error ) ? -1 : n );
+}
+
+int32 M_setblock( int32 path, const u_int8 *buffer, int32 length )
+{
+	PATH *p = pathGet( path );
+	int32 n = 0, error;
+
+	if( p == NULL )
+		return( -1 );
+
+	callEnter( p->dev );
+	error = p->dev->entry.blockWrite( p->dev->llHdl, p->ch, (void*)buffer,
+									  length, &n );
+	return( callExit( p->dev, error ) ? -1 : n );
+}
+
+int32 M_getstat( int32 path, int32 code, int32 *dataP )
+{
+	PATH *p = pathGet( path );
+	INT32_OR_64 value;
+	int32 error;
+
+	if( p == NULL )
+		return( -1 );
+
+	switch( code ){
+	case M_MK_CH_CURRENT:
+		*dataP = p->ch;
+		return( 0 );
+	case M_MK_IRQ_ENABLE:
+		*dataP = p->dev->irqEnabled;
+		return( 0 );
+	case M_MK_IO_MODE:
+		*dataP = p->ioMode;
+		return( 0 );
+	case M_MK_BLK_REV_ID:
+		return( revIdGet( p, (M_SETGETSTAT_BLOCK*)dataP ) );
+	}
+
+	callEnter( p->dev );
+	if( code & M_MK_BLK_OF ){
+		/* block getstat: pass the M_SETGETSTAT_BLOCK */
+		error = p->dev->entry.getStat( p->dev->llHdl, code, p->ch,
+									   (INT32_OR_64*)dataP );
+	}
+	else {
+		value = *dataP;
+		error = p->dev->entry.getStat( p->dev->llHdl, code, p->ch, &value );
+		if( !error )
+			*dataP = (int32)value;
+	}
+	return( callExit( p->dev, error ) );
+}
+
+int32 M_setstat( int32 path, int32 code, INT32_OR_64 data )
+{
+	PATH *p = pathGet( path );
+	int32 error;
+
+	if( p == NULL )
+		return( -1 );
+
+	switch( code ){
+	case M_MK_CH_CURRENT:
+		if( data < 0 || data >= p->dev->nbrCh ){
+			errno = ERR_MK_ILL_PARAM;
+			return( -1 );
+		}
+		p->ch = (int32)data;
+		return( 0 );
+	case M_MK_IO_MODE:
+		p->ioMode = (int32)data;
+		return( 0 );
+	}
+
+	callEnter( p->dev );
+	error = p->dev->entry.setStat( p->dev->llHdl, code, p->ch, data );
+	if( !error && code == M_MK_IRQ_ENABLE ){
+		p->dev->irqEnabled = data ? 1 : 0;
+		SIM_IrqEnable( p->dev->irqHdl, p->dev->irqEnabled && p->dev->useIrq );
+	}
+	return( callExit( p->dev, error ) );
+}
+
+char *M_errstring( int32 errCode )
+{
+	static char buf[UOS_ERRSTRING_SIZE];
+
+	return( M_errstringTs( errCode, buf ) );
+}
+
+char *M_errstringTs( int32 errCode, char *strBuf )
+{
+	int32 i;
+
+	for( i = 0; G_errTbl[i].str; i++ ){
+		if( G_errTbl[i].code == errCode ){
+			sprintf( strBuf, "ERROR (MDIS) 0x%04x:  %s", (int)errCode,
+					 G_errTbl[i].str );
+			return( strBuf );
+		}
+	}
+
+	if( errCode < ERR_MK )
+		sprintf( strBuf, "ERROR (OS) 0x%04x:  %s", (int)errCode,
+				 strerror( errCode ) );
+	else
+		sprintf( strBuf, "ERROR (MDIS) 0x%04x:  unknown error", (int)errCode );
+	return( strBuf );
+}
+
+/*-----------------------------------------+
+|  USR_OSS                                 |
++------------------------------------------*/
+int32 UOS_MikroDelayInit( void )
+{
+	return( 0 );
+}
+
+int32 UOS_MikroDelay( u_int32 usec )
+{
+	SIM_Advance( usec );
+	sigDeliver();
+	return( 0 );
+}
+
+int32 UOS_Delay( u_int32 msec )
+{
+	SIM_Advance( msec * 1000 );
+	sigDeliver();
+	return( (int32)msec );
+}
+
+u_int32 UOS_MsecTimerGet( void )
+{
+	/* let busy waiting loops see the time passing */
+	SIM_Advance( 1 );
+	sigDeliver();
+	return( (u_int32)(SIM_TimeUs() / 1000) );
+}
+
+u_int32 UOS_MsecTimerResolution( void )
+{
+	return( 1 );
+}
+
+u_int32 UOS_ErrnoGet( void )
+{
+	return( (u_int32)errno );
+}
+
+u_int32 UOS_ErrnoSet( u_int32 errCode )
+{
+	errno = (int)errCode;
+	return( errCode );
+}
+
+char *UOS_ErrString( int32 errCode )
+{
+	return( M_errstring( errCode ) );
+}
+
+char *UOS_ErrStringTs( int32 errCode, char *strBuf )
+{
+	return( M_errstringTs( errCode, strBuf ) );
+}
+
+int32 UOS_SigInit( void (*sigHandler)(u_int32 sigCode) )
+{
+	if( G_sigHandler )
+		return( ERR_OSS_BUSY_RESOURCE );
+
+	G_sigHandler = sigHandler;
+	SIM_PostEventHook( sigDeliver );
+	return( 0 );
+}
+
+int32 UOS_SigExit( void )
+{
+	G_sigHandler = NULL;
+	memset( G_sigInstalled, 0, sizeof(G_sigInstalled) );
+	SIM_PostEventHook( NULL );
+	return( 0 );
+}
+
+int32 UOS_SigInstall( u_int32 sigCode )
+{
+	if( sigCode == 0 || sigCode >= MAX_SIGNALS || G_sigInstalled[sigCode] ){
+		errno = ERR_OSS_SIG_SET;
+		return( ERR_OSS_SIG_SET );
+	}
+
+	G_sigInstalled[sigCode] = 1;
+	return( 0 );
+}
+
+int32 UOS_SigRemove( u_int32 sigCode )
+{
+	if( sigCode == 0 || sigCode >= MAX_SIGNALS || !G_sigInstalled[sigCode] ){
+		errno = ERR_OSS_SIG_SET;
+		return( ERR_OSS_SIG_SET );
+	}
+
+	G_sigInstalled[sigCode] = 0;
+	return( 0 );
+}
+
+void UOS_SigMask( void )
+{
+	G_sigMasked = 1;
+}
+
+void UOS_SigUnMask( void )
+{
+	G_sigMasked = 0;
+	sigDeliver();
+}
+
+int32 UOS_KeyPressed( void )
+{
+	return( -1 );
+}
+
+int32 UOS_KeyWait( void )
+{
+	return( -1 );
+}
+
+u_int32 UOS_Random( u_int32 old )
+{
+	return( old * 1103515245 + 12345 );
+}
+
+u_int32 UOS_RandomMap( u_int32 val, u_int32 ra, u_int32 re )
+{
+	return( ra + (u_int32)(((u_int64)val * (re - ra + 1)) >> 32) );
+}
+
+/********************************* devFind **********************************
+ *
+ *  Description:  Find a device by name.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  name   device name
+ *  Output.....:  return device or NULL
+ *  Globals....:  G_devList
+ ****************************************************************************/
+static SIM_DEV *devFind( const char *name )
+{
+	SIM_DEV *dev;
+
+	for( dev = G_devList; dev; dev = dev->next )
+		if( !strcmp( dev->name, name ) )
+			return( dev );
+
+	return( NULL );
+}
+
+/********************************* loopbackCheck ****************************
+ *
+ *  Description:  Loop back the first M22 and M24 device.
+ *
+ *                The M24 channels ch+8 follow with 1us skew by default.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  -
+ *  Globals....:  G_devList
+ ****************************************************************************/
+static void loopbackCheck( void )
+{
+	SIM_DEV *dev, *m22 = NULL, *m24 = NULL;
+	const char *env = getenv( "M22SIM_LOOPBACK" );
+	const char *skew = getenv( "M22SIM_LOOP_SKEW_US" );
+
+	if( env && !strcmp( env, "0" ) )
+		return;
+
+	for( dev = G_devList; dev; dev = dev->next ){
+		if( dev->mod.modId == 22 && m22 == NULL )
+			m22 = dev;
+		if( dev->mod.modId == 24 && m24 == NULL )
+			m24 = dev;
+	}
+
+	if( m22 && m24 && m22->mod.loop == NULL )
+		SIM_Loopback( &m22->mod, &m24->mod,
+					  skew ? (u_int32)strtoul( skew, NULL, 0 ) : 1 );
+}
+
+/********************************* stimCheck ********************************
+ *
+ *  Description:  Schedule the input stimulus of an implicit device.
+ *
+ *                M22SIM_STIM_<NAME>="<ch>,<usec>,<edges>" toggles the
+ *                input ch every usec, starting with a rising edge usec
+ *                after the open.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  dev    device
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+static void stimCheck( SIM_DEV *dev )
+{
+	char env[DEV_NAME_SIZE + 16];
+	const char *val;
+	unsigned ch, usec, edges, i;
+	int n;
+
+	n = snprintf( env, sizeof(env), "M22SIM_STIM_%s", dev->name );
+	while( --n >= 0 )
+		env[n] = (char)toupper( (unsigned char)env[n] );
+
+	if( (val = getenv( env )) == NULL ||
+		sscanf( val, "%u,%u,%u", &ch, &usec, &edges ) != 3 ||
+		ch >= SIM_MAX_CH || usec == 0 )
+		return;
+
+	for( i = 0; i < edges; i++ )
+		SIM_InputAt( &dev->mod, (i + 1) * usec, ch, !(i & 1) );
+}
+
+/********************************* devIsr ***********************************
+ *
+ *  Description:  Interrupt service routine of a device.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  arg    device
+ *  Output.....:  return LL_IRQ_xxx
+ *  Globals....:  -
+ ****************************************************************************/
+static int32 devIsr( void *arg )
+{
+	SIM_DEV *dev = arg;
+
+	return( dev->entry.irq( dev->llHdl ) );
+}
+
+/********************************* devInit **********************************
+ *
+ *  Description:  Initialize the low-level driver of a device.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  dev    device
+ *  Output.....:  return 0 | error code
+ *  Globals....:  -
+ ****************************************************************************/
+static int32 devInit( SIM_DEV *dev )
+{
+	OSS_HANDLE *osHdl = SIM_OssHandle();
+	DESC_HANDLE *descHdl;
+	MACCESS ma = &dev->mod;
+	INT32_OR_64 value;
+	u_int32 irqEnable = 0;
+	int32 error;
+
+	M22_GetEntry( &dev->entry );
+	dev->entry.info( LL_INFO_IRQ, &dev->useIrq );
+
+	if( (error = OSS_SemCreate( osHdl, OSS_SEM_BIN, 1, &dev->devSem )) )
+		return( error );
+
+	dev->irqHdl = SIM_IrqCreate( &dev->mod, devIsr, dev );
+	if( dev->irqHdl == NULL ){
+		error = ERR_OSS_MEM_ALLOC;
+		goto CLEANUP;
+	}
+
+	error = dev->entry.init( dev->desc, osHdl, &ma, dev->devSem, dev->irqHdl,
+							 &dev->llHdl );
+	if( error )
+		goto CLEANUP;
+
+	dev->entry.getStat( dev->llHdl, M_LL_CH_NUMBER, 0, &value );
+	dev->nbrCh = (int32)value;
+
+	/* kernel descriptor key */
+	if( DESC_Init( dev->desc, osHdl, &descHdl ) == 0 ){
+		DESC_GetUInt32( descHdl, 0, &irqEnable, "IRQ_ENABLE" );
+		DESC_Exit( &descHdl );
+	}
+	if( irqEnable ){
+		dev->entry.setStat( dev->llHdl, M_MK_IRQ_ENABLE, 0, 1 );
+		dev->irqEnabled = 1;
+		SIM_IrqEnable( dev->irqHdl, (int32)dev->useIrq );
+	}
+	return( 0 );
+
+ CLEANUP:
+	if( dev->llHdl )
+		dev->entry.exit( &dev->llHdl );
+	if( dev->irqHdl )
+		SIM_IrqRemove( &dev->irqHdl );
+	OSS_SemRemove( osHdl, &dev->devSem );
+	return( error );
+}
+
+/********************************* devExit **********************************
+ *
+ *  Description:  Remove the low-level driver of a device.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  dev    device
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+static void devExit( SIM_DEV *dev )
+{
+	SIM_IrqEnable( dev->irqHdl, 0 );
+	dev->irqEnabled = 0;
+	dev->entry.exit( &dev->llHdl );
+	SIM_IrqRemove( &dev->irqHdl );
+	OSS_SemRemove( SIM_OssHandle(), &dev->devSem );
+}
+
+/********************************* pathGet **********************************
+ *
+ *  Description:  Check a path number.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  path   path number
+ *  Output.....:  return path or NULL (errno set)
+ *  Globals....:  G_path
+ ****************************************************************************/
+static PATH *pathGet( int32 path )
+{
+	if( path < 0 || path >= MAX_PATHS || G_path[path].dev == NULL ){
+		errno = ERR_MK_ILL_PATH;
+		return( NULL );
+	}
+
+	return( &G_path[path] );
+}
+
+/********************************* callEnter ********************************
+ *
+ *  Description:  Lock the device for a driver call.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  dev    device
+ *  Output.....:  -
+ *  Globals....:  G_inDriver
+ ****************************************************************************/
+static void callEnter( SIM_DEV *dev )
+{
+	G_inDriver++;
+	OSS_SemWait( SIM_OssHandle(), dev->devSem, OSS_SEM_WAITFOREVER );
+}
+
+/********************************* callExit *********************************
+ *
+ *  Description:  Unlock the device after a driver call, set errno and
+ *                deliver the queued signals.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  dev    device
+ *                error  error code of the driver
+ *  Output.....:  return 0 | -1
+ *  Globals....:  G_inDriver
+ ****************************************************************************/
+static int32 callExit( SIM_DEV *dev, int32 error )
+{
+	OSS_SemSignal( SIM_OssHandle(), dev->devSem );
+	G_inDriver--;
+	sigDeliver();
+
+	if( error ){
+		errno = error;
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/********************************* sigDeliver *******************************
+ *
+ *  Description:  Call the signal handler for the queued signals.
+ *
+ *                Signals not installed are dropped.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  -
+ *  Globals....:  G_sigHandler
+ ****************************************************************************/
+static void sigDeliver( void )
+{
+	u_int32 sigNo;
+
+	if( G_inDriver || G_sigMasked || G_delivering )
+		return;
+
+	G_delivering = 1;
+	while( !G_sigMasked && SIM_SigGet( &sigNo ) ){
+		if( G_sigHandler && sigNo < MAX_SIGNALS && G_sigInstalled[sigNo] )
+			G_sigHandler( sigNo );
+	}
+	G_delivering = 0;
+}
+
+/********************************* revIdGet *********************************
+ *
+ *  Description:  Build the revision id string of a device.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  p      path
+ *                blk    user block
+ *  Output.....:  return 0 | -1
+ *  Globals....:  -
+ ****************************************************************************/
+static int32 revIdGet( PATH *p, M_SETGETSTAT_BLOCK *blk )
+{
+	MDIS_IDENT_FUNCT_TBL *tbl;
+	INT32_OR_64 value = 0;
+	char *buf = blk->data;
+	int32 i, n;
+
+	callEnter( p->dev );
+	if( callExit( p->dev, p->dev->entry.getStat( p->dev->llHdl,
+												 M_MK_BLK_REV_ID, p->ch,
+												 &value ) ) )
+		return( -1 );
+	tbl = (MDIS_IDENT_FUNCT_TBL*)value;
+
+	n = snprintf( buf, (size_t)blk->size, "MDIS kernel - host simulation\n" );
+	for( i = 0; i < MDIS_MAX_IDENT && tbl->idCall[i].identCall; i++ ){
+		if( n < blk->size )
+			n += snprintf( buf + n, (size_t)(blk->size - n), "%s\n",
+						   tbl->idCall[i].identCall() );
+	}
+	blk->size = n < blk->size ? n : blk->size;
+
+	return( 0 );
+}
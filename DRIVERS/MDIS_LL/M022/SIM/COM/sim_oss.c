@@ -0,0 +1,760 @@
+/*********************  P r o g r a m  -  M o d u l e ***********************
+ *
+ *         Name: sim_oss.c
+ *
+ *  Description: OSS and DESC layer of the host simulator
+ *
+ *               Provides the OSS and DESC functions used by m22_drv.c on
+ *               top of a simulated microsecond clock:
+ *
+ *               - alarms and scheduled input stimuli are events on the
+ *                 simulated time line, run by SIM_RunUntil()
+ *               - OSS_IrqMaskR()/OSS_IrqRestore() nest, pending module
+ *                 irqs are dispatched when the mask is released
+ *               - semaphores wait by running the time line
+ *               - signals are queued for sim_mdis.c
+ *               - the descriptor is a "KEY=value" text, entries separated
+ *                 by ';', ',' or white space
+ *
+ *     Required: -
+ *     Switches: -
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <MEN/men_typs.h>
+#include <MEN/maccess.h>
+#include <MEN/oss.h>
+#include <MEN/desc.h>
+#include <MEN/mdis_err.h>
+
+#include "sim.h"
+
+/*-----------------------------------------+
+|  DEFINES                                 |
++------------------------------------------*/
+#define IRQ_STORM_MAX	1000	/* isr calls per dispatch until irq disabled */
+#define SIG_QUEUE_SIZE	4096	/* queued signals */
+#define DESC_KEY_MAX	64
+
+/*-----------------------------------------+
+|  TYPEDEFS                                |
++------------------------------------------*/
+struct OSS_HANDLE {
+	int32				dummy;
+};
+
+struct OSS_IRQ_HANDLE {
+	SIM_MOD				*mod;
+	int32				(*isr)( void *arg );
+	void				*arg;
+	int32				enabled;
+	struct OSS_IRQ_HANDLE *next;
+};
+
+struct OSS_ALARM_HANDLE {
+	void				(*funct)( void *arg );
+	void				*arg;
+	int32				active;
+	u_int64				due;		/* [us] */
+	u_int64				period;		/* [us], 0 = single shot */
+	struct OSS_ALARM_HANDLE *next;
+};
+
+struct OSS_SEM_HANDLE {
+	int32				type;
+	int32				count;
+};
+
+struct OSS_SIG_HANDLE {
+	int32				sigNo;
+};
+
+struct DESC_HANDLE {
+	char				*text;
+};
+
+typedef struct {
+	u_int64				time;		/* [us] */
+	SIM_MOD				*mod;
+	u_int32				ch;
+	u_int32				level;
+} STIMULUS;
+
+/*-----------------------------------------+
+|  STATICS                                 |
++------------------------------------------*/
+static struct OSS_HANDLE	G_osHdl;
+static u_int64				G_timeUs;
+static int32				G_maskDepth;
+static int32				G_inIsr;
+static OSS_IRQ_HANDLE		*G_irqList;
+static OSS_ALARM_HANDLE		*G_alarmList;
+static STIMULUS				*G_stim;
+static u_int32				G_stimNbr, G_stimSize;
+static u_int32				G_sigQueue[SIG_QUEUE_SIZE];
+static u_int32				G_sigIn, G_sigOut;
+static int32				G_memBlocks;
+static void					(*G_postHook)( void );
+
+/*-----------------------------------------+
+|  PROTOTYPES                              |
++------------------------------------------*/
+static int32 semAvail( void *arg );
+
+/********************************* SIM_TimeUs *******************************
+ *
+ *  Description:  Get the simulated time.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return time since start [us]
+ *  Globals....:  G_timeUs
+ ****************************************************************************/
+u_int64 SIM_TimeUs( void )
+{
+	return( G_timeUs );
+}
+
+/********************************* SIM_Advance ******************************
+ *
+ *  Description:  Advance the simulated time and run the due events.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  usec   time to advance [us]
+ *  Output.....:  -
+ *  Globals....:  G_timeUs
+ ****************************************************************************/
+void SIM_Advance( u_int32 usec )
+{
+	SIM_RunUntil( G_timeUs + usec, NULL, NULL );
+}
+
+/********************************* SIM_Stall ********************************
+ *
+ *  Description:  Advance the simulated time without running events, like
+ *                a system busy with irqs off. Due alarms run late at the
+ *                next SIM_Advance().
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  usec   time to advance [us]
+ *  Output.....:  -
+ *  Globals....:  G_timeUs
+ ****************************************************************************/
+void SIM_Stall( u_int32 usec )
+{
+	G_timeUs += usec;
+}
+
+/********************************* SIM_RunUntil *****************************
+ *
+ *  Description:  Run the events of the time line until a deadline or
+ *                until a condition is met.
+ *
+ *                Input stimuli are applied before alarms due at the same
+ *                time. The post event hook is called after each event.
+ *                With SIM_FOREVER the function returns when no more
+ *                events are scheduled.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  deadline  absolute time [us] or SIM_FOREVER
+ *                cond      condition or NULL
+ *                arg       argument of cond
+ *  Output.....:  return 1 if the condition is met
+ *  Globals....:  G_timeUs, G_alarmList, G_stim
+ ****************************************************************************/
+int32 SIM_RunUntil( u_int64 deadline, int32 (*cond)(void *arg), void *arg )
+{
+	OSS_ALARM_HANDLE *alm, *next;
+	STIMULUS stim;
+
+	for(;;){
+		if( cond && cond( arg ) )
+			return( 1 );
+
+		/* find the next event */
+		next = NULL;
+		for( alm = G_alarmList; alm; alm = alm->next )
+			if( alm->active && (next == NULL || alm->due < next->due) )
+				next = alm;
+
+		if( G_stimNbr && G_stim[0].time <= deadline &&
+			(next == NULL || G_stim[0].time <= next->due) ){
+			stim = G_stim[0];
+			memmove( &G_stim[0], &G_stim[1],
+					 --G_stimNbr * sizeof(STIMULUS) );
+			if( stim.time > G_timeUs )
+				G_timeUs = stim.time;
+			SIM_InputSet( stim.mod, stim.ch, stim.level );
+		}
+		else if( next && next->due <= deadline ){
+			if( next->due > G_timeUs )
+				G_timeUs = next->due;
+			if( next->period )
+				next->due += next->period;
+			else
+				next->active = 0;
+			next->funct( next->arg );
+		}
+		else
+			break;
+
+		if( G_postHook )
+			G_postHook();
+	}/*for*/
+
+	if( deadline != SIM_FOREVER && deadline > G_timeUs )
+		G_timeUs = deadline;
+
+	return( cond ? cond( arg ) : 0 );
+}
+
+/********************************* SIM_InputAt ******************************
+ *
+ *  Description:  Schedule an input level change.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  mod    module model
+ *                usec   time from now [us]
+ *                ch     channel
+ *                level  0 or !=0
+ *  Output.....:  return 0 | error code
+ *  Globals....:  G_stim
+ ****************************************************************************/
+int32 SIM_InputAt( SIM_MOD *mod, u_int32 usec, u_int32 ch, u_int32 level )
+{
+	STIMULUS *stim;
+	u_int64 time = G_timeUs + usec;
+	u_int32 i;
+
+	if( G_stimNbr == G_stimSize ){
+		stim = realloc( G_stim, (G_stimSize + 256) * sizeof(STIMULUS) );
+		if( stim == NULL )
+			return( ERR_OSS_MEM_ALLOC );
+		G_stim = stim;
+		G_stimSize += 256;
+	}
+
+	/* keep sorted, same time in order of scheduling */
+	for( i = G_stimNbr; i > 0 && G_stim[i-1].time > time; i-- )
+		G_stim[i] = G_stim[i-1];
+
+	G_stim[i].time  = time;
+	G_stim[i].mod   = mod;
+	G_stim[i].ch    = ch;
+	G_stim[i].level = level;
+	G_stimNbr++;
+
+	return( 0 );
+}
+
+/********************************* SIM_PostEventHook ************************
+ *
+ *  Description:  Install a function called after each time line event.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  hook   function or NULL
+ *  Output.....:  -
+ *  Globals....:  G_postHook
+ ****************************************************************************/
+void SIM_PostEventHook( void (*hook)(void) )
+{
+	G_postHook = hook;
+}
+
+/********************************* SIM_CycleGet *****************************
+ *
+ *  Description:  Get the host time stamp counter for M22_STAT_TIME.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return host monotonic time [ns], wraps around
+ *  Globals....:  -
+ ****************************************************************************/
+u_int32 SIM_CycleGet( void )
+{
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return( (u_int32)((u_int64)ts.tv_sec * 1000000000ULL + ts.tv_nsec) );
+}
+
+/********************************* SIM_IrqCheck *****************************
+ *
+ *  Description:  Dispatch the pending module irqs.
+ *
+ *                Does nothing while the irqs are masked or an isr is
+ *                running. The isr is called as long as the line is
+ *                asserted, a storm disables the irq.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  -
+ *  Globals....:  G_irqList, G_maskDepth, G_inIsr
+ ****************************************************************************/
+void SIM_IrqCheck( void )
+{
+	OSS_IRQ_HANDLE *irq;
+	int32 calls = 0, pending;
+
+	if( G_maskDepth || G_inIsr )
+		return;
+
+	G_inIsr = 1;
+	do {
+		pending = 0;
+		for( irq = G_irqList; irq; irq = irq->next ){
+			if( irq->enabled && SIM_IrqLine( irq->mod ) ){
+				pending = 1;
+				irq->isr( irq->arg );
+			}
+		}
+		if( pending && ++calls == IRQ_STORM_MAX ){
+			fprintf( stderr, "*** SIM: irq storm, irqs disabled\n" );
+			for( irq = G_irqList; irq; irq = irq->next )
+				if( SIM_IrqLine( irq->mod ) )
+					irq->enabled = 0;
+		}
+	} while( pending );
+	G_inIsr = 0;
+}
+
+/********************************* SIM_IrqCreate ****************************
+ *
+ *  Description:  Connect the irq of a module model to an isr.
+ *
+ *                The irq is created disabled.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  mod    module model
+ *                isr    interrupt service routine
+ *                arg    argument of isr
+ *  Output.....:  return irq handle or NULL
+ *  Globals....:  G_irqList
+ ****************************************************************************/
+OSS_IRQ_HANDLE *SIM_IrqCreate( SIM_MOD *mod, int32 (*isr)(void *arg),
+							   void *arg )
+{
+	OSS_IRQ_HANDLE *irq = calloc( 1, sizeof(*irq) );
+
+	if( irq == NULL )
+		return( NULL );
+
+	irq->mod  = mod;
+	irq->isr  = isr;
+	irq->arg  = arg;
+	irq->next = G_irqList;
+	G_irqList = irq;
+
+	return( irq );
+}
+
+/********************************* SIM_IrqEnable ****************************
+ *
+ *  Description:  Enable or disable an irq.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  irqHdl  irq handle
+ *                enable  0 or 1
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+void SIM_IrqEnable( OSS_IRQ_HANDLE *irqHdl, int32 enable )
+{
+	irqHdl->enabled = enable;
+	if( enable )
+		SIM_IrqCheck();
+}
+
+/********************************* SIM_IrqRemove ****************************
+ *
+ *  Description:  Remove an irq handle.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  irqHdlP  pointer to irq handle
+ *  Output.....:  *irqHdlP NULL
+ *  Globals....:  G_irqList
+ ****************************************************************************/
+void SIM_IrqRemove( OSS_IRQ_HANDLE **irqHdlP )
+{
+	OSS_IRQ_HANDLE **pp;
+
+	for( pp = &G_irqList; *pp; pp = &(*pp)->next ){
+		if( *pp == *irqHdlP ){
+			*pp = (*pp)->next;
+			break;
+		}
+	}
+	free( *irqHdlP );
+	*irqHdlP = NULL;
+}
+
+/********************************* SIM_OssHandle ****************************
+ *
+ *  Description:  Get the OSS handle passed to the driver.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return OSS handle
+ *  Globals....:  G_osHdl
+ ****************************************************************************/
+OSS_HANDLE *SIM_OssHandle( void )
+{
+	return( &G_osHdl );
+}
+
+/********************************* SIM_SigGet *******************************
+ *
+ *  Description:  Get the next queued signal.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  sigNoP  signal number
+ *  Output.....:  return 1 if a signal was queued
+ *  Globals....:  G_sigQueue
+ ****************************************************************************/
+int32 SIM_SigGet( u_int32 *sigNoP )
+{
+	if( G_sigOut == G_sigIn )
+		return( 0 );
+
+	*sigNoP = G_sigQueue[G_sigOut++ % SIG_QUEUE_SIZE];
+	return( 1 );
+}
+
+/********************************* SIM_MemBlocks ****************************
+ *
+ *  Description:  Get the number of memory blocks allocated by the driver.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return number of blocks
+ *  Globals....:  G_memBlocks
+ ****************************************************************************/
+int32 SIM_MemBlocks( void )
+{
+	return( G_memBlocks );
+}
+
+/*-----------------------------------------+
+|  OSS                                     |
++------------------------------------------*/
+char *OSS_Ident( void )
+{
+	return( "OSS - M22 host simulation" );
+}
+
+void *OSS_MemGet( OSS_HANDLE *osHdl, u_int32 size, u_int32 *gotsizeP )
+{
+	void *addr = malloc( size ? size : 1 );
+
+	*gotsizeP = addr ? size : 0;
+	if( addr )
+		G_memBlocks++;
+	return( addr );
+}
+
+int32 OSS_MemFree( OSS_HANDLE *osHdl, void *addr, u_int32 size )
+{
+	if( addr ){
+		free( addr );
+		G_memBlocks--;
+	}
+	return( 0 );
+}
+
+void OSS_MemFill( OSS_HANDLE *osHdl, u_int32 size, char *adr, int8 value )
+{
+	memset( adr, value, size );
+}
+
+void OSS_MemCopy( OSS_HANDLE *osHdl, u_int32 size, char *src, char *dest )
+{
+	memmove( dest, src, size );
+}
+
+int32 OSS_SigCreate( OSS_HANDLE *osHdl, int32 signal,
+					 OSS_SIG_HANDLE **sigHdlP )
+{
+	OSS_SIG_HANDLE *sig;
+	u_int32 gotsize;
+
+	*sigHdlP = NULL;
+	if( signal == 0 )
+		return( ERR_OSS_SIG_SET );
+
+	sig = OSS_MemGet( osHdl, sizeof(*sig), &gotsize );
+	if( sig == NULL )
+		return( ERR_OSS_MEM_ALLOC );
+
+	sig->sigNo = signal;
+	*sigHdlP = sig;
+	return( 0 );
+}
+
+int32 OSS_SigRemove( OSS_HANDLE *osHdl, OSS_SIG_HANDLE **sigHdlP )
+{
+	OSS_MemFree( osHdl, *sigHdlP, sizeof(OSS_SIG_HANDLE) );
+	*sigHdlP = NULL;
+	return( 0 );
+}
+
+int32 OSS_SigSend( OSS_HANDLE *osHdl, OSS_SIG_HANDLE *sigHdl )
+{
+	if( G_sigIn - G_sigOut == SIG_QUEUE_SIZE )
+		return( ERR_OSS_SIG_SET );		/* receiver doesn't keep up */
+
+	G_sigQueue[G_sigIn++ % SIG_QUEUE_SIZE] = (u_int32)sigHdl->sigNo;
+	return( 0 );
+}
+
+int32 OSS_SigInfo( OSS_HANDLE *osHdl, OSS_SIG_HANDLE *sigHdl,
+				   int32 *signalNbrP, int32 *processIdP )
+{
+	*signalNbrP = sigHdl->sigNo;
+	*processIdP = (int32)getpid();
+	return( 0 );
+}
+
+int32 OSS_SemCreate( OSS_HANDLE *osHdl, int32 semType, int32 initVal,
+					 OSS_SEM_HANDLE **semHandleP )
+{
+	OSS_SEM_HANDLE *sem;
+	u_int32 gotsize;
+
+	sem = OSS_MemGet( osHdl, sizeof(*sem), &gotsize );
+	*semHandleP = sem;
+	if( sem == NULL )
+		return( ERR_OSS_MEM_ALLOC );
+
+	sem->type  = semType;
+	sem->count = initVal;
+	return( 0 );
+}
+
+int32 OSS_SemRemove( OSS_HANDLE *osHdl, OSS_SEM_HANDLE **semHandleP )
+{
+	OSS_MemFree( osHdl, *semHandleP, sizeof(OSS_SEM_HANDLE) );
+	*semHandleP = NULL;
+	return( 0 );
+}
+
+int32 OSS_SemWait( OSS_HANDLE *osHdl, OSS_SEM_HANDLE *semHandle, int32 msec )
+{
+	u_int64 deadline;
+
+	if( semHandle->count == 0 ){
+		if( msec == OSS_SEM_NOWAIT )
+			return( ERR_OSS_TIMEOUT );
+
+		/* nobody else runs: wait for alarms, stimuli or the isr */
+		deadline = msec < 0 ? SIM_FOREVER : G_timeUs + (u_int64)msec * 1000;
+		if( !SIM_RunUntil( deadline, semAvail, semHandle ) )
+			return( ERR_OSS_TIMEOUT );
+	}
+
+	semHandle->count--;
+	return( 0 );
+}
+
+int32 OSS_SemSignal( OSS_HANDLE *osHdl, OSS_SEM_HANDLE *semHandle )
+{
+	if( semHandle->type == OSS_SEM_BIN )
+		semHandle->count = 1;
+	else
+		semHandle->count++;
+	return( 0 );
+}
+
+int32 OSS_AlarmCreate( OSS_HANDLE *osHdl, void (*funct)(void *arg),
+					   void *arg, OSS_ALARM_HANDLE **alarmP )
+{
+	OSS_ALARM_HANDLE *alm;
+	u_int32 gotsize;
+
+	alm = OSS_MemGet( osHdl, sizeof(*alm), &gotsize );
+	*alarmP = alm;
+	if( alm == NULL )
+		return( ERR_OSS_MEM_ALLOC );
+
+	memset( alm, 0, sizeof(*alm) );
+	alm->funct  = funct;
+	alm->arg    = arg;
+	alm->next   = G_alarmList;
+	G_alarmList = alm;
+	return( 0 );
+}
+
+int32 OSS_AlarmRemove( OSS_HANDLE *osHdl, OSS_ALARM_HANDLE **alarmP )
+{
+	OSS_ALARM_HANDLE **pp;
+
+	for( pp = &G_alarmList; *pp; pp = &(*pp)->next ){
+		if( *pp == *alarmP ){
+			*pp = (*pp)->next;
+			break;
+		}
+	}
+	OSS_MemFree( osHdl, *alarmP, sizeof(OSS_ALARM_HANDLE) );
+	*alarmP = NULL;
+	return( 0 );
+}
+
+int32 OSS_AlarmSet( OSS_HANDLE *osHdl, OSS_ALARM_HANDLE *alarm,
+					u_int32 msec, u_int32 cyclic, u_int32 *realMsecP )
+{
+	if( alarm->active ){
+		fprintf( stderr, "*** SIM: OSS_AlarmSet() on active alarm\n" );
+		return( ERR_OSS_BUSY_RESOURCE );
+	}
+
+	/* at least one tick */
+	if( msec == 0 )
+		msec = 1;
+
+	alarm->due    = G_timeUs + (u_int64)msec * 1000;
+	alarm->period = cyclic ? (u_int64)msec * 1000 : 0;
+	alarm->active = 1;
+	*realMsecP    = msec;
+	return( 0 );
+}
+
+int32 OSS_AlarmClear( OSS_HANDLE *osHdl, OSS_ALARM_HANDLE *alarm )
+{
+	if( !alarm->active )
+		return( ERR_OSS_ILL_PARAM );
+
+	alarm->active = 0;
+	return( 0 );
+}
+
+u_int32 OSS_TickGet( OSS_HANDLE *osHdl )
+{
+	return( (u_int32)(G_timeUs / (1000000 / SIM_TICK_RATE)) );
+}
+
+u_int32 OSS_TickRateGet( OSS_HANDLE *osHdl )
+{
+	return( SIM_TICK_RATE );
+}
+
+int32 OSS_MikroDelayInit( OSS_HANDLE *osHdl )
+{
+	return( 0 );
+}
+
+int32 OSS_MikroDelay( OSS_HANDLE *osHdl, u_int32 mikroSec )
+{
+	SIM_Advance( mikroSec );
+	return( 0 );
+}
+
+OSS_IRQ_STATE OSS_IrqMaskR( OSS_HANDLE *osHdl, OSS_IRQ_HANDLE *irqHdl )
+{
+	return( G_maskDepth++ );
+}
+
+void OSS_IrqRestore( OSS_HANDLE *osHdl, OSS_IRQ_HANDLE *irqHdl,
+					 OSS_IRQ_STATE oldState )
+{
+	G_maskDepth = oldState;
+	if( G_maskDepth == 0 )
+		SIM_IrqCheck();
+}
+
+/*-----------------------------------------+
+|  DESC                                    |
++------------------------------------------*/
+char *DESC_Ident( void )
+{
+	return( "DESC - M22 host simulation" );
+}
+
+int32 DESC_Init( DESC_SPEC *descSpec, OSS_HANDLE *osHdl,
+				 DESC_HANDLE **descHandleP )
+{
+	DESC_HANDLE *desc;
+	const char *text = descSpec ? (const char*)descSpec : "";
+
+	desc = calloc( 1, sizeof(*desc) );
+	if( desc == NULL || (desc->text = strdup( text )) == NULL ){
+		free( desc );
+		return( ERR_OSS_MEM_ALLOC );
+	}
+
+	*descHandleP = desc;
+	return( 0 );
+}
+
+int32 DESC_Exit( DESC_HANDLE **descHandleP )
+{
+	free( (*descHandleP)->text );
+	free( *descHandleP );
+	*descHandleP = NULL;
+	return( 0 );
+}
+
+int32 DESC_GetUInt32( DESC_HANDLE *descHandle, u_int32 defVal,
+					  u_int32 *valueP, char *keyFmt, ... )
+{
+	static const char sep[] = "; ,\t\r\n";
+	char key[DESC_KEY_MAX];
+	const char *p = descHandle->text;
+	size_t len;
+	va_list ap;
+
+	va_start( ap, keyFmt );
+	vsnprintf( key, sizeof(key), keyFmt, ap );
+	va_end( ap );
+	len = strlen( key );
+
+	while( *(p += strspn( p, sep )) ){
+		if( !strncmp( p, key, len ) && p[len] == '=' ){
+			*valueP = (u_int32)strtoul( p + len + 1, NULL, 0 );
+			return( 0 );
+		}
+		p += strcspn( p, sep );
+	}
+
+	*valueP = defVal;
+	return( ERR_DESC_KEY_NOTFOUND );
+}
+
+int32 DESC_DbgLevelSet( DESC_HANDLE *descHandle, u_int32 dbgLevel )
+{
+	return( 0 );
+}
+
+/********************************* semAvail *********************************
+ *
+ *  Description:  SIM_RunUntil() condition of OSS_SemWait().
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  arg    semaphore
+ *  Output.....:  return 1 if the semaphore can be taken
+ *  Globals....:  -
+ ****************************************************************************/
+static int32 semAvail( void *arg )
+{
+	return( ((OSS_SEM_HANDLE*)arg)->count > 0 );
+}
@@ -0,0 +1,523 @@
+/*********************  P r o g r a m  -  M o d u l e ***********************
+ *
+ *         Name: m22_bench.c
+ *      Project: MDIS 4.x
+ *
+ *  Description: throughput and latency benchmark of the m22_drv.c
+ *
+ *               Every test calls one MDIS function n times and times each
+ *               call (or each batch of calls, see -b). One CSV line per
+ *               test and device is written:
+ *
+ *               test,device,ch,calls,errors,lost,calls_per_s,
+ *               min_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns
+ *
+ *               calls_per_s is computed from the sum of the timed calls.
+ *               The loopback test writes the M22 output ch and waits with
+ *               M22_24_GETBLOCK_WAIT_EVENT for the edge on M24 input ch
+ *               (test adapter: M22 ch #d - M24 ch #d ch #d+8). Edges not
+ *               seen within the wait timeout are counted as lost.
+ *
+ *     Required: M24 descriptor with EVENT_BUF_SIZE for the loopback test
+ *     Switches: LINUX - nanosecond clock, otherwise UOS_MsecTimerGet()
+ *                       (use -b to time batches of calls)
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <MEN/men_typs.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LINUX
+	#include <time.h>
+#endif
+
+#include <MEN/usr_oss.h>
+#include <MEN/mdis_api.h>
+#include <MEN/mdis_err.h>
+
+#include <MEN/m22_drv.h>
+
+static const char IdentString[]=MENT_XSTR(MAK_REVISION);
+
+/*-----------------------------------------+
+|  TYPEDEFS                                |
++------------------------------------------*/
+/* benchmarked calls */
+typedef enum {
+	B_READ,
+	B_WRITE,
+	B_GETBLOCK,
+	B_SETBLOCK,
+	B_CLR_INPUT_EDGE,
+	B_CLR_INPUT_EDGE_BLK,
+	B_CLR_ALARM_EDGE,
+	B_CLR_ALARM_EDGE_BLK
+} BENCH_OP;
+
+/* result of one test */
+typedef struct {
+	u_int32		calls;			/* timed calls */
+	u_int32		errors;			/* failed calls */
+	u_int32		lost;			/* loopback edges not seen */
+	u_int32		*sample;		/* ns per call */
+	u_int32		nbrSamples;
+	double		sumNs;			/* sum of all samples * batch */
+} BENCH_RES;
+
+/*-----------------------------------------+
+|  DEFINES & CONST                         |
++------------------------------------------*/
+#define BENCH_CALLS		10000		/* default calls per test */
+#define BENCH_WAIT_MS	100			/* default loopback timeout */
+
+static const struct {
+	const char	*name;
+	BENCH_OP	op;
+	int			m22Only;			/* output or alarm function */
+} G_test[] = {
+	{ "read",				B_READ,					0 },
+	{ "write",				B_WRITE,				1 },
+	{ "getblock",			B_GETBLOCK,				0 },
+	{ "setblock",			B_SETBLOCK,				1 },
+	{ "clr_input_edge",		B_CLR_INPUT_EDGE,		0 },
+	{ "clr_input_edge_blk",	B_CLR_INPUT_EDGE_BLK,	0 },
+	{ "clr_alarm_edge",		B_CLR_ALARM_EDGE,		1 },
+	{ "clr_alarm_edge_blk",	B_CLR_ALARM_EDGE_BLK,	1 },
+};
+
+/*-----------------------------------------+
+|  STATICS                                 |
++------------------------------------------*/
+static u_int32	G_calls = BENCH_CALLS;
+static u_int32	G_batch = 1;
+static int32	G_ch;
+static int32	G_waitMs = BENCH_WAIT_MS;
+static FILE		*G_out;
+
+/*-----------------------------------------+
+|  PROTOTYPES                              |
++------------------------------------------*/
+static void usage( void );
+static u_int32 nsGet( void );
+static int32 benchCall( BENCH_OP op, int32 fd, u_int32 i );
+static int32 benchRun( BENCH_OP op, int32 fd, BENCH_RES *res );
+static int32 loopRun( int32 m22Fd, int32 m24Fd, BENCH_RES *res );
+static int32 chActivate( int32 fd, int32 ch, int32 edgeMask );
+static void csvWrite( const char *test, const char *dev, BENCH_RES *res );
+static int cmpU32( const void *a, const void *b );
+
+/********************************* usage ************************************
+ *
+ *  Description:  Print program usage.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+static void usage( void )
+{
+	printf("usage: m22_bench [<opts>] <device name m22> [<device name m24>]\n");
+	printf("Function: throughput and latency of the M22/M24 i/o path as CSV\n");
+	printf("Options:\n");
+	printf("    -n=<calls>   calls per test ................ [%d]\n", BENCH_CALLS );
+	printf("    -c=<ch>      channel ....................... [0]\n");
+	printf("    -b=<batch>   calls per time sample ......... [1]\n");
+	printf("    -w=<ms>      loopback wait timeout ......... [%d]\n", BENCH_WAIT_MS );
+	printf("    -t=<test>    run this test only ............ [all]\n");
+	printf("                 read, write, getblock, setblock, clr_input_edge,\n");
+	printf("                 clr_input_edge_blk, clr_alarm_edge,\n");
+	printf("                 clr_alarm_edge_blk, loopback\n");
+	printf("    -o=<file>    CSV output file ............... [stdout]\n");
+	printf("requires: M22 ch #d and M24 ch #d active, for the loopback test\n");
+	printf("          the test adapter m22 ch #d - m24 ch #d ch #d+8 (d=0..7)\n");
+	printf("          and EVENT_BUF_SIZE in the M24 descriptor\n");
+	printf("%s\n", IdentString );
+	printf("(c) 2026 by MEN mikro elektronik GmbH\n\n");
+}
+
+/********************************* main *************************************
+ *
+ *  Description:  Run the selected tests on the given devices.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  argc, argv   [<opts>] <m22 device> [<m24 device>]
+ *  Output.....:  return       0 = ok, 1 = error
+ *  Globals....:  -
+ ****************************************************************************/
+int main( int argc, char *argv[] )
+{
+	char		*devName[2] = { NULL, NULL };
+	char		*only = NULL, *outFile = NULL;
+	char		buf[UOS_ERRSTRING_SIZE];
+	int32		fd[2] = { -1, -1 };
+	int32		nbrDev = 0, d, error = 0;
+	u_int32		i;
+	BENCH_RES	res;
+
+	for( i = 1; i < (u_int32)argc; i++ ){
+		if( !strncmp( argv[i], "-n=", 3 ) )
+			G_calls = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-c=", 3 ) )
+			G_ch = (int32)strtol( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-b=", 3 ) )
+			G_batch = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-w=", 3 ) )
+			G_waitMs = (int32)strtol( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-t=", 3 ) )
+			only = argv[i] + 3;
+		else if( !strncmp( argv[i], "-o=", 3 ) )
+			outFile = argv[i] + 3;
+		else if( argv[i][0] == '-' || nbrDev == 2 ){
+			usage();
+			return( 1 );
+		}
+		else
+			devName[nbrDev++] = argv[i];
+	}
+
+	if( nbrDev == 0 || G_calls == 0 || G_batch == 0 ||
+		G_ch < 0 || G_ch >= M22_MAX_CH ){
+		usage();
+		return( 1 );
+	}
+
+	G_out = stdout;
+	if( outFile && (G_out = fopen( outFile, "w" )) == NULL ){
+		printf("*** can't create %s\n", outFile );
+		return( 1 );
+	}
+
+	/* the loopback test takes one sample per call, regardless of -b */
+	res.sample = (u_int32*)malloc( G_calls * sizeof(u_int32) );
+	if( res.sample == NULL ){
+		printf("*** can't alloc sample buffer\n");
+		error = 1;
+		goto CLEANUP;
+	}
+
+	/*--------------------+
+	|  open devices       |
+	+--------------------*/
+	for( d = 0; d < nbrDev; d++ ){
+		if( (fd[d] = M_open( devName[d] )) < 0 ||
+			chActivate( fd[d], G_ch, d ? M22_24_RISING_EDGE_ENABLE |
+						M22_24_FALLING_EDGE_ENABLE : -1 ) ){
+			printf("*** %s: %s\n", devName[d],
+				   M_errstringTs( UOS_ErrnoGet(), buf ) );
+			error = 1;
+			goto CLEANUP;
+		}
+	}
+
+	fprintf( G_out, "test,device,ch,calls,errors,lost,calls_per_s,"
+			 "min_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns\n" );
+
+	/*--------------------+
+	|  single calls       |
+	+--------------------*/
+	for( i = 0; i < sizeof(G_test) / sizeof(G_test[0]); i++ ){
+		if( only && strcmp( only, G_test[i].name ) )
+			continue;
+
+		for( d = 0; d < (G_test[i].m22Only ? 1 : nbrDev); d++ ){
+			if( benchRun( G_test[i].op, fd[d], &res ) )
+				error = 1;
+			csvWrite( G_test[i].name, devName[d], &res );
+		}
+	}
+
+	/*--------------------+
+	|  loopback M22->M24  |
+	+--------------------*/
+	if( nbrDev == 2 && (!only || !strcmp( only, "loopback" )) ){
+		if( loopRun( fd[0], fd[1], &res ) )
+			error = 1;
+		csvWrite( "loopback", devName[1], &res );
+	}
+
+CLEANUP:
+	for( d = 0; d < nbrDev; d++ )
+		if( fd[d] >= 0 )
+			M_close( fd[d] );
+
+	if( res.sample )
+		free( res.sample );
+	if( G_out && G_out != stdout )
+		fclose( G_out );
+
+	return( error );
+}
+
+/********************************* nsGet ************************************
+ *
+ *  Description:  Get a free running time stamp.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return  time [ns], wraps after 4.29s
+ *  Globals....:  -
+ ****************************************************************************/
+static u_int32 nsGet( void )
+{
+#ifdef LINUX
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return( (u_int32)ts.tv_sec * 1000000000 + (u_int32)ts.tv_nsec );
+#else
+	return( UOS_MsecTimerGet() * 1000000 );
+#endif
+}
+
+/********************************* benchCall ********************************
+ *
+ *  Description:  Do one benchmarked call.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  op     call
+ *                fd     path
+ *                i      call index (output value)
+ *  Output.....:  return 0 | -1
+ *  Globals....:  -
+ ****************************************************************************/
+static int32 benchCall( BENCH_OP op, int32 fd, u_int32 i )
+{
+	static u_int8 blk[M24_MAX_CH];
+	int32 value;
+
+	switch( op ){
+	case B_READ:
+		return( M_read( fd, &value ) );
+	case B_WRITE:
+		return( M_write( fd, (int32)(i & 1) ) );
+	case B_GETBLOCK:
+		return( M_getblock( fd, blk, M24_MAX_CH ) < 0 ? -1 : 0 );
+	case B_SETBLOCK:
+		memset( blk, (int)(i & 1), M22_MAX_CH );
+		return( M_setblock( fd, blk, M22_MAX_CH ) < 0 ? -1 : 0 );
+	case B_CLR_INPUT_EDGE:
+		return( M_setstat( fd, M22_24_CLEAR_INPUT_EDGE, 0 ) );
+	case B_CLR_INPUT_EDGE_BLK:
+	case B_CLR_ALARM_EDGE_BLK:
+	{
+		M_SETGETSTAT_BLOCK blkStruct;
+
+		blkStruct.size = 0;
+		blkStruct.data = (void*)blk;
+		return( M_setstat( fd, op == B_CLR_INPUT_EDGE_BLK ?
+						   M22_24_SETBLOCK_CLEAR_INPUT_EDGE :
+						   M22_SETBLOCK_CLEAR_ALARM_EDGE,
+						   (INT32_OR_64)&blkStruct ) );
+	}
+	case B_CLR_ALARM_EDGE:
+		return( M_setstat( fd, M22_CLEAR_ALARM_EDGE, 0 ) );
+	default:
+		return( -1 );
+	}
+}
+
+/********************************* benchRun *********************************
+ *
+ *  Description:  Time G_calls calls in batches of G_batch.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  op     call
+ *                fd     path
+ *                res    result
+ *  Output.....:  return 0 | 1 = calls failed
+ *  Globals....:  G_calls, G_batch
+ *  Output.....:  res
+ ****************************************************************************/
+static int32 benchRun( BENCH_OP op, int32 fd, BENCH_RES *res )
+{
+	u_int32 i, b, t;
+
+	res->calls = res->errors = res->lost = res->nbrSamples = 0;
+	res->sumNs = 0;
+
+	for( i = 0; i + G_batch <= G_calls; i += G_batch ){
+		t = nsGet();
+		for( b = 0; b < G_batch; b++ )
+			if( benchCall( op, fd, i + b ) )
+				res->errors++;
+		t = nsGet() - t;
+
+		res->sumNs += t;
+		res->sample[res->nbrSamples++] = t / G_batch;
+		res->calls += G_batch;
+	}
+
+	return( res->errors ? 1 : 0 );
+}
+
+/********************************* loopRun **********************************
+ *
+ *  Description:  Time M22 output write to M24 input event.
+ *
+ *                The M24 irq is enabled during the test. The event buffer
+ *                is flushed before each write. The wait skips events of
+ *                other channels (ch+8) and directions.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  m22Fd  M22 path
+ *                m24Fd  M24 path
+ *                res    result
+ *  Output.....:  return 0 | 1 = calls failed
+ *  Globals....:  G_calls, G_ch, G_waitMs
+ *  Output.....:  res
+ ****************************************************************************/
+static int32 loopRun( int32 m22Fd, int32 m24Fd, BENCH_RES *res )
+{
+	M_SETGETSTAT_BLOCK	blkStruct;
+	M22_24_WAIT			wt;
+	u_int32				i, t, start;
+	int32				level, edge, irqEnable;
+
+	res->calls = res->errors = res->lost = res->nbrSamples = 0;
+	res->sumNs = 0;
+
+	/* start with output off */
+	if( M_getstat( m24Fd, M_MK_IRQ_ENABLE, &irqEnable ) ||
+		M_setstat( m24Fd, M_MK_IRQ_ENABLE, 1 ) ||
+		M_write( m22Fd, 0 ) ){
+		res->errors++;
+		return( 1 );
+	}
+	UOS_Delay( 10 );
+
+	blkStruct.size = sizeof(wt);
+	blkStruct.data = (void*)&wt;
+
+	for( i = 0; i < G_calls; i++ ){
+		level = (int32)((i + 1) & 1);
+		edge  = level ? M22_24_READ_RISING_EDGE : M22_24_READ_FALLING_EDGE;
+
+		if( M_setstat( m24Fd, M22_24_EVENT_COUNT, 0 ) ){
+			res->errors++;
+			continue;
+		}
+
+		t = start = nsGet();
+		if( M_write( m22Fd, level ) ){
+			res->errors++;
+			continue;
+		}
+
+		for(;;){
+			wt.timeout = G_waitMs - (int32)((nsGet() - start) / 1000000);
+			if( wt.timeout <= 0 ||
+				M_getstat( m24Fd, M22_24_GETBLOCK_WAIT_EVENT,
+						   (int32*)&blkStruct ) ){
+				res->lost++;
+				t = 0;
+				break;
+			}
+			if( wt.ev.ch == G_ch && !(wt.ev.flags & M22_EV_ALARM) &&
+				(wt.ev.flags & edge) ){
+				t = nsGet() - t;
+				break;
+			}
+		}
+
+		res->calls++;
+		if( t ){
+			res->sumNs += t;
+			res->sample[res->nbrSamples++] = t;
+		}
+	}
+
+	M_write( m22Fd, 0 );
+	M_setstat( m24Fd, M_MK_IRQ_ENABLE, irqEnable );
+	return( res->errors ? 1 : 0 );
+}
+
+/********************************* chActivate *******************************
+ *
+ *  Description:  Select, activate and configure the benchmark channel.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  fd        path
+ *                ch        channel
+ *                edgeMask  M22_24_INPUT_EDGE_MASK or -1 to keep
+ *  Output.....:  return    0 | -1
+ *  Globals....:  -
+ ****************************************************************************/
+static int32 chActivate( int32 fd, int32 ch, int32 edgeMask )
+{
+	if( M_setstat( fd, M_MK_CH_CURRENT, ch ) ||
+		M_setstat( fd, M22_24_CHANNEL_INACTIVE, 0 ) )
+		return( -1 );
+
+	if( edgeMask >= 0 &&
+		M_setstat( fd, M22_24_INPUT_EDGE_MASK, edgeMask ) )
+		return( -1 );
+
+	return( 0 );
+}
+
+/********************************* csvWrite *********************************
+ *
+ *  Description:  Write the CSV line of a test.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  test   test name
+ *                dev    device name
+ *                res    result, samples get sorted
+ *  Output.....:  -
+ *  Globals....:  G_out, G_ch
+ ****************************************************************************/
+static void csvWrite( const char *test, const char *dev, BENCH_RES *res )
+{
+	static const u_int32 perMille[] = { 0, 500, 900, 990, 999, 1000 };
+	u_int32 i, n = res->nbrSamples;
+
+	fprintf( G_out, "%s,%s,%d,%u,%u,%u,%.0f", test, dev, (int)G_ch,
+			 (unsigned)res->calls, (unsigned)res->errors,
+			 (unsigned)res->lost,
+			 res->sumNs > 0 ? (double)(res->calls - res->lost) * 1e9 /
+			 res->sumNs : 0.0 );
+
+	qsort( res->sample, n, sizeof(u_int32), cmpU32 );
+	for( i = 0; i < sizeof(perMille) / sizeof(perMille[0]); i++ )
+		fprintf( G_out, ",%u", n ? (unsigned)res->sample[
+					 (u_int32)(((double)(n - 1) * perMille[i]) / 1000)] : 0 );
+
+	fprintf( G_out, "\n" );
+	fflush( G_out );
+}
+
+/********************************* cmpU32 ***********************************
+ *
+ *  Description:  qsort() compare function.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  a, b   u_int32 elements
+ *  Output.....:  return <0, 0, >0
+ *  Globals....:  -
+ ****************************************************************************/
+static int cmpU32( const void *a, const void *b )
+{
+	u_int32 x = *(const u_int32*)a, y = *(const u_int32*)b;
+
+	return( x < y ? -1 : x > y );
+}
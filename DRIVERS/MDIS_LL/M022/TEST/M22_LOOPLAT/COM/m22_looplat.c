@@ -0,0 +1,486 @@
+/*********************  P r o g r a m  -  M o d u l e ***********************
+ *
+ *         Name: m22_looplat.c
+ *      Project: MDIS 4.x
+ *
+ *  Description: loopback edge to notification latency of the m22_drv.c
+ *
+ *               Toggles M22 output ch at the given rates and measures the
+ *               time from M_write() to the arrival of the M24 input ch
+ *               event (M22_24_GETBLOCK_WAIT_EVENT) or signal (channel
+ *               filtered subscription). For each rate a latency histogram
+ *               and the number of lost edges is printed.
+ *
+ *               Events are matched to the written edges by direction, so
+ *               a single lost edge is found at once. Signals carry no
+ *               direction and are matched in order.
+ *               Edges without notification after the drain time (-w) are
+ *               lost.
+ *
+ *     Required: test adapter m22 ch #d - m24 ch #d ch #d+8
+ *               M24 descriptor with EVENT_BUF_SIZE for the event mode
+ *     Switches: LINUX - nanosecond clock, otherwise UOS_MsecTimerGet()
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <MEN/men_typs.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LINUX
+	#include <time.h>
+#endif
+
+#include <MEN/usr_oss.h>
+#include <MEN/mdis_api.h>
+#include <MEN/mdis_err.h>
+
+#include <MEN/m22_drv.h>
+
+static const char IdentString[]=MENT_XSTR(MAK_REVISION);
+
+/*-----------------------------------------+
+|  DEFINES & CONST                         |
++------------------------------------------*/
+#define LAT_EDGES		1000		/* default edges per rate */
+#define LAT_DRAIN_MS	100			/* default drain time */
+#define LAT_MAX_RATES	16
+#define LAT_HIST_SIZE	22			/* <1us, 1us, 2us .. 2^20us */
+
+#define LAT_MODE_SIG	0
+#define LAT_MODE_EVENT	1
+
+#define LAT_RISING(i)	(!((i) & 1))	/* edge 0 is rising */
+
+/*-----------------------------------------+
+|  TYPEDEFS                                |
++------------------------------------------*/
+/* result of one rate */
+typedef struct {
+	u_int32		rate;				/* edges per second */
+	u_int32		edges;				/* written edges */
+	u_int32		seen;				/* matched notifications */
+	u_int32		spurious;			/* notifications without edge */
+	u_int64		minNs, maxNs, sumNs;
+	u_int32		hist[LAT_HIST_SIZE];
+} LAT_RES;
+
+/*-----------------------------------------+
+|  STATICS                                 |
++------------------------------------------*/
+static int32				G_ch;
+static int32				G_mode = LAT_MODE_EVENT;
+static u_int32				G_edges = LAT_EDGES;
+static int32				G_m22Fd = -1, G_m24Fd = -1;
+static u_int64				*G_wrTime;		/* M_write time of edge i */
+static volatile u_int32		G_wrCount;		/* written edges */
+static u_int32				G_match;		/* next edge to match */
+static u_int64				*G_sigTime;		/* arrival time of signal i */
+static volatile u_int32		G_sigCount;
+static u_int32				G_sigDone;		/* processed signals */
+
+/*-----------------------------------------+
+|  PROTOTYPES                              |
++------------------------------------------*/
+static void usage( void );
+static u_int64 nsGet( void );
+static void sighdl( u_int32 sigNo );
+static int32 rateRun( u_int32 rate, u_int32 drainMs, LAT_RES *res );
+static void collect( u_int64 until, int drain, LAT_RES *res );
+static void edgeMatch( int32 rising, u_int64 arrival, LAT_RES *res );
+static void resShow( LAT_RES *res );
+
+/********************************* usage ************************************
+ *
+ *  Description:  Print program usage.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+static void usage( void )
+{
+	printf("usage: m22_looplat [<opts>] <device name m22> <device name m24>\n");
+	printf("Function: M22 output edge to M24 notification latency\n");
+	printf("Options:\n");
+	printf("    -r=<rates>   edges per second, comma list .. [10,100,1000]\n");
+	printf("    -n=<edges>   edges per rate ................ [%d]\n", LAT_EDGES );
+	printf("    -c=<ch>      channel 0..7 .................. [0]\n");
+	printf("    -m=<mode>    0 = signal, 1 = event ......... [1]\n");
+	printf("    -w=<ms>      drain time after each rate .... [%d]\n", LAT_DRAIN_MS );
+	printf("requires: test adapter m22 ch #d - m24 ch #d ch #d+8 (d=0..7)\n");
+	printf("          EVENT_BUF_SIZE in the M24 descriptor for mode 1\n");
+	printf("%s\n", IdentString );
+	printf("(c) 2026 by MEN mikro elektronik GmbH\n\n");
+}
+
+/********************************* main *************************************
+ *
+ *  Description:  Measure the latency at all rates.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  argc, argv   [<opts>] <m22 device> <m24 device>
+ *  Output.....:  return       0 = no edge lost, 1 = error or lost edges
+ *  Globals....:  -
+ ****************************************************************************/
+int main( int argc, char *argv[] )
+{
+	char		*devName[2] = { NULL, NULL };
+	char		*rateStr = "10,100,1000", *p;
+	char		buf[UOS_ERRSTRING_SIZE];
+	u_int32		rate[LAT_MAX_RATES], nbrRates = 0, drainMs = LAT_DRAIN_MS;
+	u_int32		i, nbrDev = 0, lost = 0;
+	int32		error = 1;
+	LAT_RES		res;
+	M_SETGETSTAT_BLOCK	blkStruct;
+	M22_24_SUBSCRIBE	sub;
+
+	for( i = 1; i < (u_int32)argc; i++ ){
+		if( !strncmp( argv[i], "-r=", 3 ) )
+			rateStr = argv[i] + 3;
+		else if( !strncmp( argv[i], "-n=", 3 ) )
+			G_edges = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-c=", 3 ) )
+			G_ch = (int32)strtol( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-m=", 3 ) )
+			G_mode = (int32)strtol( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-w=", 3 ) )
+			drainMs = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+		else if( argv[i][0] == '-' || nbrDev == 2 ){
+			usage();
+			return( 1 );
+		}
+		else
+			devName[nbrDev++] = argv[i];
+	}
+
+	for( p = rateStr; *p && nbrRates < LAT_MAX_RATES; ){
+		if( (rate[nbrRates] = (u_int32)strtoul( p, &p, 0 )) != 0 )
+			nbrRates++;
+		if( *p != ',' )
+			break;
+		p++;
+	}
+
+	if( nbrDev != 2 || nbrRates == 0 || G_edges == 0 ||
+		G_ch < 0 || G_ch >= M22_MAX_CH ||
+		(G_mode != LAT_MODE_SIG && G_mode != LAT_MODE_EVENT) ){
+		usage();
+		return( 1 );
+	}
+
+	G_wrTime  = (u_int64*)malloc( G_edges * sizeof(u_int64) );
+	G_sigTime = (u_int64*)malloc( G_edges * sizeof(u_int64) );
+	if( G_wrTime == NULL || G_sigTime == NULL ){
+		printf("*** can't alloc time buffers\n");
+		goto CLEANUP;
+	}
+
+	/*--------------------+
+	|  open and config    |
+	+--------------------*/
+	if( (G_m22Fd = M_open( devName[0] )) < 0 ||
+		(G_m24Fd = M_open( devName[1] )) < 0 ||
+		M_setstat( G_m22Fd, M_MK_CH_CURRENT, G_ch ) ||
+		M_setstat( G_m22Fd, M22_24_CHANNEL_INACTIVE, 0 ) ||
+		M_write( G_m22Fd, 0 ) ||
+		M_setstat( G_m24Fd, M_MK_CH_CURRENT, G_ch ) ||
+		M_setstat( G_m24Fd, M22_24_CHANNEL_INACTIVE, 0 ) ||
+		M_setstat( G_m24Fd, M22_24_INPUT_EDGE_MASK,
+				   M22_24_RISING_EDGE_ENABLE | M22_24_FALLING_EDGE_ENABLE ) ||
+		M_setstat( G_m24Fd, M_MK_IRQ_ENABLE, 1 ) ){
+		printf("*** open/config: %s\n", M_errstringTs( UOS_ErrnoGet(), buf ) );
+		goto CLEANUP;
+	}
+
+	if( G_mode == LAT_MODE_SIG ){
+		sub.sigNo	 = UOS_SIG_USR1;
+		sub.chMask	 = 1 << G_ch;
+		sub.edgeMask = 0;
+		blkStruct.size = sizeof(sub);
+		blkStruct.data = (void*)&sub;
+		if( UOS_SigInit( sighdl ) || UOS_SigInstall( UOS_SIG_USR1 ) ||
+			M_setstat( G_m24Fd, M22_24_SETBLOCK_SIG_SUBSCRIBE,
+					   (INT32_OR_64)&blkStruct ) ){
+			printf("*** signal: %s\n", M_errstringTs( UOS_ErrnoGet(), buf ) );
+			goto CLEANUP;
+		}
+	}
+
+	printf("M22 ch %d -> M24 ch %d, %s, %u edges per rate\n", (int)G_ch,
+		   (int)G_ch, G_mode == LAT_MODE_SIG ? "signal" : "event",
+		   (unsigned)G_edges );
+
+	/*--------------------+
+	|  all rates          |
+	+--------------------*/
+	error = 0;
+	for( i = 0; i < nbrRates; i++ ){
+		if( rateRun( rate[i], drainMs, &res ) ){
+			printf("*** rate %u: %s\n", (unsigned)rate[i],
+				   M_errstringTs( UOS_ErrnoGet(), buf ) );
+			error = 1;
+			break;
+		}
+		resShow( &res );
+		lost += res.edges - res.seen;
+	}
+
+	printf("\n=== %u edges lost ===\n", (unsigned)lost );
+	if( lost )
+		error = 1;
+
+CLEANUP:
+	if( G_mode == LAT_MODE_SIG && G_m24Fd >= 0 ){
+		M_setstat( G_m24Fd, M22_24_SIG_UNSUBSCRIBE, UOS_SIG_USR1 );
+		UOS_SigRemove( UOS_SIG_USR1 );
+		UOS_SigExit();
+	}
+	if( G_m22Fd >= 0 ){
+		M_write( G_m22Fd, 0 );
+		M_close( G_m22Fd );
+	}
+	if( G_m24Fd >= 0 )
+		M_close( G_m24Fd );
+
+	if( G_wrTime )
+		free( G_wrTime );
+	if( G_sigTime )
+		free( G_sigTime );
+
+	return( error );
+}
+
+/********************************* nsGet ************************************
+ *
+ *  Description:  Get a free running time stamp.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return  time [ns]
+ *  Globals....:  -
+ ****************************************************************************/
+static u_int64 nsGet( void )
+{
+#ifdef LINUX
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return( (u_int64)ts.tv_sec * 1000000000 + (u_int64)ts.tv_nsec );
+#else
+	return( (u_int64)UOS_MsecTimerGet() * 1000000 );
+#endif
+}
+
+/********************************* sighdl ***********************************
+ *
+ *  Description:  Signal handler, stores the arrival time.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  sigNo  signal number
+ *  Output.....:  -
+ *  Globals....:  G_sigTime, G_sigCount
+ ****************************************************************************/
+static void sighdl( u_int32 sigNo )
+{
+	if( sigNo == UOS_SIG_USR1 && G_sigCount < G_edges )
+		G_sigTime[G_sigCount++] = nsGet();
+}
+
+/********************************* rateRun **********************************
+ *
+ *  Description:  Write G_edges edges at the given rate and collect the
+ *                notifications in between and during the drain time.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  rate     edges per second
+ *                drainMs  max. wait for late notifications
+ *                res      result
+ *  Output.....:  return   0 | -1 = M_write() failed
+ *  Globals....:  G_wrTime, G_wrCount, G_match, G_sigCount, G_sigDone
+ ****************************************************************************/
+static int32 rateRun( u_int32 rate, u_int32 drainMs, LAT_RES *res )
+{
+	u_int64	start, period = 1000000000 / rate;
+	u_int32	i;
+
+	memset( res, 0, sizeof(*res) );
+	res->rate	= rate;
+	res->minNs	= (u_int64)-1;
+
+	/* output is off, forget old notifications */
+	UOS_Delay( 10 );
+	if( G_mode == LAT_MODE_EVENT &&
+		M_setstat( G_m24Fd, M22_24_EVENT_COUNT, 0 ) )
+		return( -1 );
+	G_wrCount = G_match = G_sigCount = G_sigDone = 0;
+
+	start = nsGet();
+	for( i = 0; i < G_edges; i++ ){
+		collect( start + i * period, 0, res );
+
+		G_wrTime[i] = nsGet();
+		if( M_write( G_m22Fd, LAT_RISING(i) ) )
+			return( -1 );
+		G_wrCount = i + 1;
+		res->edges++;
+	}
+
+	collect( nsGet() + (u_int64)drainMs * 1000000, 1, res );
+
+	/* an odd number of edges leaves the output on */
+	if( G_edges & 1 )
+		M_write( G_m22Fd, 0 );
+
+	return( 0 );
+}
+
+/********************************* collect **********************************
+ *
+ *  Description:  Take notifications until the given time.
+ *
+ *                Event mode blocks in M22_24_GETBLOCK_WAIT_EVENT while
+ *                at least 2ms are left, otherwise it polls. Signal mode
+ *                sleeps in UOS_Delay() or polls.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  until  end time [ns]
+ *                drain  1 = return when all written edges are seen
+ *                res    result
+ *  Output.....:  -
+ *  Globals....:  G_ch, G_mode, G_sigTime, G_sigCount, G_sigDone
+ ****************************************************************************/
+static void collect( u_int64 until, int drain, LAT_RES *res )
+{
+	M_SETGETSTAT_BLOCK	blkStruct;
+	M22_24_WAIT			wt;
+	u_int64				now;
+	int32				msLeft;
+
+	blkStruct.size = sizeof(wt);
+	blkStruct.data = (void*)&wt;
+
+	while( (now = nsGet()) < until ){
+		if( drain && G_match == G_wrCount )
+			break;
+
+		msLeft = (int32)((until - now) / 1000000);
+
+		if( G_mode == LAT_MODE_EVENT ){
+			wt.timeout = msLeft >= 2 ? msLeft - 1 : 0;
+			if( M_getstat( G_m24Fd, M22_24_GETBLOCK_WAIT_EVENT,
+						   (int32*)&blkStruct ) )
+				continue;
+
+			now = nsGet();
+			if( wt.ev.ch == G_ch && !(wt.ev.flags & M22_EV_ALARM) )
+				edgeMatch( (wt.ev.flags & M22_24_READ_RISING_EDGE) ? 1 : 0,
+						   now, res );
+		}
+		else {
+			while( G_sigDone < G_sigCount )
+				edgeMatch( -1, G_sigTime[G_sigDone++], res );
+			if( msLeft >= 2 )
+				UOS_Delay( 1 );
+		}
+	}
+}
+
+/********************************* edgeMatch ********************************
+ *
+ *  Description:  Match a notification to the oldest written edge.
+ *
+ *                Edges of the other direction before it were lost.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  rising   1 = rising, 0 = falling, -1 = unknown (signal)
+ *                arrival  arrival time [ns]
+ *                res      result
+ *  Output.....:  -
+ *  Globals....:  G_wrTime, G_wrCount, G_match
+ ****************************************************************************/
+static void edgeMatch( int32 rising, u_int64 arrival, LAT_RES *res )
+{
+	u_int64	lat;
+	u_int32	us, b;
+
+	if( rising >= 0 )
+		while( G_match < G_wrCount && LAT_RISING(G_match) != rising )
+			G_match++;
+
+	if( G_match == G_wrCount ){
+		res->spurious++;
+		return;
+	}
+
+	lat = arrival - G_wrTime[G_match++];
+	res->seen++;
+	res->sumNs += lat;
+	if( lat < res->minNs )
+		res->minNs = lat;
+	if( lat > res->maxNs )
+		res->maxNs = lat;
+
+	/* bucket 0: <1us, bucket b: 2^(b-1)..2^b-1 us */
+	us = lat / 1000 > 0xffffffff ? 0xffffffff : (u_int32)(lat / 1000);
+	for( b = 0; us && b < LAT_HIST_SIZE - 1; b++ )
+		us >>= 1;
+	res->hist[b]++;
+}
+
+/********************************* resShow **********************************
+ *
+ *  Description:  Print the result and histogram of one rate.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  res    result
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+static void resShow( LAT_RES *res )
+{
+	u_int32 b;
+
+	printf("\nrate %u/s: %u edges, %u seen, %u lost, %u spurious\n",
+		   (unsigned)res->rate, (unsigned)res->edges, (unsigned)res->seen,
+		   (unsigned)(res->edges - res->seen), (unsigned)res->spurious );
+	if( !res->seen )
+		return;
+
+	printf("latency [us]: min %u avg %u max %u\n",
+		   (unsigned)(res->minNs / 1000),
+		   (unsigned)(res->sumNs / res->seen / 1000),
+		   (unsigned)(res->maxNs / 1000) );
+
+	for( b = 0; b < LAT_HIST_SIZE; b++ ){
+		if( !res->hist[b] )
+			continue;
+		if( b == 0 )
+			printf("  %8s < %7u us", "", 1 );
+		else if( b == LAT_HIST_SIZE - 1 )
+			printf("  %7u .. %7s us", 1U << (b - 1), "" );
+		else
+			printf("  %7u .. %7u us", 1U << (b - 1), (1U << b) - 1 );
+		printf(" %8u %5.1f%%\n", (unsigned)res->hist[b],
+			   100.0 * res->hist[b] / res->seen );
+	}
+}
@@ -8,6 +8,10 @@
  *  Description: test of the m22_drv.c m22_drv.h
  *               signal handling and buffer modes
  *
+ *               Soak mode (-s=<sec>): randomized edges on all M22 outputs
+ *               for a long time, running totals of expected and observed
+ *               M24 edges, signals and interrupts.
+ *
  *     Required: USE M22_MAX.DSC!!!
  *     Switches: -
  *
@@ -80,6 +84,7 @@ static int  m24SignalCount;
 
 static int m22_openclose( char *devName );
 static int m22_m24_test( char *devNameM22, char *devNameM24, int endless );
+static int m22_soak( char *devNameM22, char *devNameM24, int argc, char *argv[] );
 
 static void sighdl( u_int32 sigNo );
 
@@ -107,14 +112,28 @@ int main( int argc, char *argv[] )
     printf("Automatic Test Program for M22/M24\n");
     if( argc < 2){
         printf("usage: m22_main <device name m22> <device name m24> [<n>]\n");
+        printf("       m22_main <device name m22> <device name m24> -s=<sec> [<opts>]\n");
 	    printf("requires: maximal descriptor all channels inactive and enabled edges\n");
     	printf("          external test adapter with loop   m22 ch #d - m24 ch #d ch #d+8 (d=0..7)\n");
     	printf("          n - number of runs - default 1 - 0 is endless\n");
     	printf("The M24 needs the M22 for test stimuli.\n");
+    	printf("soak mode: randomized edges on all channels\n");
+    	printf("    -s=<sec>     duration - 0 is endless\n");
+    	printf("    -r=<sec>     report interval ........... [10]\n");
+    	printf("    -d=<us>      max. random pause per step  [0]\n");
+    	printf("    -i=<mode>    M22_24_IRQ_MODE of the M24  [0]\n");
         return 1;
     }
 	UOS_MikroDelayInit();
 
+	if( argc > 3 && !strncmp( argv[3], "-s=", 3 ) )
+	{
+		error = m22_soak( argv[1], argv[2], argc - 3, argv + 3 );
+		if( error )
+			line = __LINE__;
+		goto CLEANUP;
+	}
+
 	n = 1;
 	if( argc == 4 )
 	{
@@ -1046,6 +1065,240 @@ M22_TESTERR:
     return( 1 );
 }/*m22_m24_test*/
 
+/**************************** m22_soak **************************************
+ *
+ *  Description:  Soak and stress test with loss accounting.
+ *
+ *                Toggles random sets of the M22 outputs, either all at once
+ *                by M22_PORT_OUTPUTS_MODIFY or one channel by M_write(),
+ *                with optional random pauses. Each toggled output must give
+ *                two M24 edges (ch #d and ch #d+8).
+ *
+ *                Running totals, expected values from the stimulus:
+ *                edges    expected: 2 per toggled output
+ *                         observed: M22_24_SIG_PENDING of the M24
+ *                irqs     expected: INTREG mode one per edge, scan mode
+ *                         at least one per step (edges switched together
+ *                         may share an irq), shown as "min"
+ *                         observed: M22_24_GETBLOCK_IRQ_STATS of the M24
+ *                signals  observed: signal handler count
+ *                         Pending signals of the same number may merge,
+ *                         so they aren't compared to the irqs. Each report
+ *                         interval with edges must give a signal at
+ *                         least, and there must be no signal send errors.
+ *
+ *                Missing edges or irqs, report intervals with edges but
+ *                without signal and signal send errors are an error.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  devNameM22  M22 device name
+ *                devNameM24  M24 device name
+ *                argc, argv  soak options, argv[0] is -s=<sec>
+ *
+ *  Output.....:  return  T_OK or T_ERROR
+ *
+ *  Globals....:  m24SignalCount
+ *
+ ****************************************************************************/
+static int m22_soak( char *devNameM22, char *devNameM24, int argc, char *argv[] )
+{
+	u_int32  duration, report = 10, maxPause = 0, irqMode = 0;
+	u_int32  start, now, lastReport, rnd, tgl, out = 0, ch, i;
+	u_int32  steps = 0, lastSteps = 0, expEdges = 0, obsEdges = 0;
+	u_int32  expIrqs = 0, obsIrqs = 0, obsSigs = 0, lastSigs = 0;
+	u_int32  edgeIntervals = 0, noSigIntervals = 0;
+	u_int32  lostEdges, lostIrqs;
+	int32    pending;
+	int      ret = T_ERROR, done = 0;
+	int32    m22Fd = -1;
+	int32    m24Fd = -1;
+	char     errMsg[100];
+	M_SETGETSTAT_BLOCK blkStruct;
+	M22_24_IRQ_STATS   stats;
+
+	duration = (u_int32)strtoul( argv[0] + 3, NULL, 0 );
+	for( i = 1; i < (u_int32)argc; i++ )
+	{
+		if( !strncmp( argv[i], "-r=", 3 ) )
+			report = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-d=", 3 ) )
+			maxPause = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-i=", 3 ) )
+			irqMode = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+	}/*for*/
+	if( report == 0 )
+		report = 10;
+
+	printf("=========================\n");
+	printf("M22/M24 soak test %u s%s, report every %u s\n", (unsigned)duration,
+		   duration ? "" : " (endless)", (unsigned)report );
+
+	m24SignalCount = 0;
+	sprintf( errMsg, "%s", "UOS_SigInit/UOS_SigInstall" );
+	if( UOS_SigInit( sighdl ) || UOS_SigInstall( UOS_SIG_USR2 ) )
+		goto SOAK_ERR;
+
+	/*-------------------------------+
+	|  M22: all outputs active, off  |
+	|  M24: all inputs, both edges   |
+	+-------------------------------*/
+	sprintf( errMsg, "%s %s", "M_open/config", devNameM22 );
+	if( (m22Fd = M_open( devNameM22 )) < 0 ) goto SOAK_ERR;
+	for( ch = 0; ch < M22_MAX_CH; ch++ )
+	{
+		if( M_setstat( m22Fd, M_MK_CH_CURRENT, ch ) ||
+			M_setstat( m22Fd, M22_24_CHANNEL_INACTIVE, 0 ) ||
+			M_setstat( m22Fd, M22_24_INPUT_EDGE_MASK, 0 ) ||
+			M_write( m22Fd, 0 ) )
+			goto SOAK_ERR;
+	}/*for*/
+
+	sprintf( errMsg, "%s %s", "M_open/config", devNameM24 );
+	if( (m24Fd = M_open( devNameM24 )) < 0 ) goto SOAK_ERR;
+	for( ch = 0; ch < M24_MAX_CH; ch++ )
+	{
+		if( M_setstat( m24Fd, M_MK_CH_CURRENT, ch ) ||
+			M_setstat( m24Fd, M22_24_CHANNEL_INACTIVE, 0 ) ||
+			M_setstat( m24Fd, M22_24_INPUT_EDGE_MASK,
+					   M22_24_RISING_EDGE_ENABLE | M22_24_FALLING_EDGE_ENABLE ) )
+			goto SOAK_ERR;
+	}/*for*/
+	if( M_setstat( m24Fd, M22_24_IRQ_MODE, irqMode ) ||
+		M_setstat( m24Fd, M22_24_SIG_EDGE_OCCURRED, UOS_SIG_USR2 ) ||
+		M_setstat( m24Fd, M_MK_IRQ_ENABLE, 1 ) )
+		goto SOAK_ERR;
+
+	/* start with clean counters */
+	UOS_Delay( 100 );
+	sprintf( errMsg, "%s", "M_setstat/M_getstat statistics" );
+	if( M_setstat( m24Fd, M22_24_IRQ_STATS_CLEAR, 0 ) ||
+		M_getstat( m24Fd, M22_24_SIG_PENDING, &pending ) )
+		goto SOAK_ERR;
+	m24SignalCount = 0;
+
+	blkStruct.size = sizeof(stats);
+	blkStruct.data = (void*)&stats;
 
+	start = lastReport = UOS_MsecTimerGet();
+	rnd = start;
+	while( !done )
+	{
+		/*-----------------------+
+		|  random toggle step    |
+		+-----------------------*/
+		rnd = UOS_Random( rnd );
+		if( rnd & 0x80000000 )
+		{
+			/* one channel */
+			ch  = UOS_RandomMap( rnd, 0, M22_MAX_CH - 1 );
+			tgl = 1 << ch;
+			sprintf( errMsg, "%s", "M_write" );
+			if( M_setstat( m22Fd, M_MK_CH_CURRENT, ch ) ||
+				M_write( m22Fd, (out & tgl) ? 0 : 1 ) )
+				goto SOAK_ERR;
+		}
+		else
+		{
+			/* several channels at once */
+			tgl = UOS_RandomMap( rnd, 1, (1 << M22_MAX_CH) - 1 );
+			sprintf( errMsg, "%s", "M_setstat M22_PORT_OUTPUTS_MODIFY" );
+			if( M_setstat( m22Fd, M22_PORT_OUTPUTS_MODIFY, M22_OUT_MODIFY( 0, 0, tgl ) ) )
+				goto SOAK_ERR;
+		}/*if*/
+		out ^= tgl;
+		steps++;
+		if( irqMode == M22_24_IRQ_MODE_SCAN )
+			expIrqs++;
+		for( ; tgl; tgl &= tgl - 1 )
+		{
+			expEdges += 2;
+			if( irqMode != M22_24_IRQ_MODE_SCAN )
+				expIrqs += 2;
+		}/*for*/
 
+		if( maxPause )
+		{
+			rnd = UOS_Random( rnd );
+			UOS_MikroDelay( UOS_RandomMap( rnd, 0, maxPause ) );
+		}/*if*/
+
+		/*-----------------------+
+		|  report                |
+		+-----------------------*/
+		now = UOS_MsecTimerGet();
+		if( duration && now - start >= duration * 1000 )
+		{
+			/* let the last edges arrive */
+			done = 1;
+			UOS_Delay( 100 );
+		}
+		else if( now - lastReport < report * 1000 )
+			continue;
+
+		sprintf( errMsg, "%s", "M_getstat statistics" );
+		if( M_getstat( m24Fd, M22_24_SIG_PENDING, &pending ) ||
+			M_getstat( m24Fd, M22_24_GETBLOCK_IRQ_STATS, (int32*)&blkStruct ) )
+			goto SOAK_ERR;
+		obsEdges += pending;
+
+		obsIrqs = stats.irqCount - stats.irqSpurious;
+		obsSigs = m24SignalCount;
+		if( pending )
+		{
+			edgeIntervals++;
+			if( obsSigs == lastSigs )
+				noSigIntervals++;
+		}/*if*/
+		lastSigs = obsSigs;
+
+		printf("%7u s: %u steps (%u/s) edges exp %u obs %u | irqs %s %u obs %u | signals obs %u\n",
+			   (unsigned)((now - start) / 1000), (unsigned)steps,
+			   (unsigned)((steps - lastSteps) * 1000 / (now - lastReport ? now - lastReport : 1)),
+			   (unsigned)expEdges, (unsigned)obsEdges,
+			   irqMode == M22_24_IRQ_MODE_SCAN ? "min" : "exp", (unsigned)expIrqs,
+			   (unsigned)obsIrqs, (unsigned)obsSigs );
+		fflush(stdout);
+		lastReport = now;
+		lastSteps  = steps;
+	}/*while*/
+
+	lostEdges = expEdges > obsEdges ? expEdges - obsEdges : 0;
+	lostIrqs  = expIrqs > obsIrqs ? expIrqs - obsIrqs : 0;
+	printf("totals: edges exp %u obs %u lost %u | irqs %s %u obs %u lost %u spurious %u | signals obs %u, %u of %u intervals with edges without signal (send errors %u)\n",
+		   (unsigned)expEdges, (unsigned)obsEdges, (unsigned)lostEdges,
+		   irqMode == M22_24_IRQ_MODE_SCAN ? "min" : "exp",
+		   (unsigned)expIrqs, (unsigned)obsIrqs, (unsigned)lostIrqs,
+		   (unsigned)stats.irqSpurious, (unsigned)obsSigs,
+		   (unsigned)noSigIntervals, (unsigned)edgeIntervals,
+		   (unsigned)stats.sigSendErr );
+
+	if( lostEdges || lostIrqs || noSigIntervals || stats.sigSendErr ||
+		obsEdges > expEdges )
+		printf("=== soak finished - ERROR ===\n");
+	else
+	{
+		printf("=== soak finished - OK ===\n");
+		ret = T_OK;
+	}/*if*/
+	goto SOAK_END;
+
+SOAK_ERR:
+	errShow( errMsg );
+	printf("=== soak finished - ERROR ===\n");
 
+SOAK_END:
+	if( m24Fd != -1 )
+	{
+		M_setstat( m24Fd, M22_24_SIG_CLR_EDGE_OCCURRED, 0 );
+		M_close( m24Fd );
+	}/*if*/
+	if( m22Fd != -1 )
+	{
+		M_setstat( m22Fd, M22_PORT_OUTPUTS, 0 );
+		M_close( m22Fd );
+	}/*if*/
+	UOS_SigRemove( UOS_SIG_USR2 );
+	UOS_SigExit();
+	fflush(stdout);
+	return( ret );
+}/*m22_soak*/
@@ -0,0 +1,276 @@
+/*********************  P r o g r a m  -  M o d u l e ***********************
+ *
+ *         Name: m22_rec.c
+ *      Project: MDIS 4.x
+ *
+ *  Description: records the edge events of an M22/M24 into a binary file
+ *
+ *               The events are taken in blocks from the driver's event
+ *               buffer (M22_24_GETBLOCK_WAIT_EVENT for the first,
+ *               M22_24_GETBLOCK_EVENTS for the rest) and written unchanged
+ *               as fixed size records, see m22_rec.h.
+ *               Gaps in the driver's sequence numbers are counted as lost.
+ *               Recording stops after -n events, -t seconds or a key.
+ *
+ *     Required: EVENT_BUF_SIZE in the device descriptor
+ *     Switches: -
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <MEN/men_typs.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <MEN/usr_oss.h>
+#include <MEN/mdis_api.h>
+#include <MEN/mdis_err.h>
+
+#include <MEN/m22_drv.h>
+#include <MEN/m22_rec.h>
+
+static const char IdentString[]=MENT_XSTR(MAK_REVISION);
+
+/*-----------------------------------------+
+|  DEFINES & CONST                         |
++------------------------------------------*/
+#define REC_BLOCK		256			/* events per read */
+#define REC_WAIT_MS		100			/* max. wait for an event */
+
+/*-----------------------------------------+
+|  PROTOTYPES                              |
++------------------------------------------*/
+static void usage( void );
+static int32 chSetup( int32 fd, int32 nbrCh );
+
+/********************************* usage ************************************
+ *
+ *  Description:  Print program usage.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+static void usage( void )
+{
+	printf("usage: m22_rec [<opts>] <device> <file>\n");
+	printf("Function: record M22/M24 edge events into a binary file\n");
+	printf("Options:\n");
+	printf("    -n=<events>  stop after n events .......... [0=no]\n");
+	printf("    -t=<sec>     stop after t seconds ......... [0=no]\n");
+	printf("    -a           activate all channels, both edges\n");
+	printf("                 (otherwise as in the descriptor)\n");
+	printf("requires: EVENT_BUF_SIZE in the device descriptor\n");
+	printf("press any key to stop\n");
+	printf("%s\n", IdentString );
+	printf("(c) 2026 by MEN mikro elektronik GmbH\n\n");
+}
+
+/********************************* main *************************************
+ *
+ *  Description:  Record until the stop condition.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  argc, argv   [<opts>] <device> <file>
+ *  Output.....:  return       0 = ok, 1 = error
+ *  Globals....:  -
+ ****************************************************************************/
+int main( int argc, char *argv[] )
+{
+	char		*devName = NULL, *fileName = NULL;
+	char		buf[UOS_ERRSTRING_SIZE];
+	int32		fd = -1, all = 0, nbrCh, tickRate, error = 1, n;
+	u_int32		maxEvents = 0, maxSec = 0, start, elapsed, i;
+	u_int32		count = 0, lost = 0, nextSeq = 0;
+	FILE		*fp = NULL;
+	M22_REC_HDR			hdr;
+	M22_REC_EVENT		*ev = NULL;
+	M22_24_WAIT			wt;
+	M_SETGETSTAT_BLOCK	blkStruct;
+
+	for( i = 1; i < (u_int32)argc; i++ ){
+		if( !strncmp( argv[i], "-n=", 3 ) )
+			maxEvents = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-t=", 3 ) )
+			maxSec = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+		else if( !strcmp( argv[i], "-a" ) )
+			all = 1;
+		else if( argv[i][0] == '-' ){
+			usage();
+			return( 1 );
+		}
+		else if( devName == NULL )
+			devName = argv[i];
+		else if( fileName == NULL )
+			fileName = argv[i];
+	}
+
+	if( devName == NULL || fileName == NULL ){
+		usage();
+		return( 1 );
+	}
+
+	if( (ev = (M22_REC_EVENT*)malloc( REC_BLOCK * sizeof(*ev) )) == NULL ){
+		printf("*** can't alloc event buffer\n");
+		return( 1 );
+	}
+
+	/*--------------------+
+	|  open device        |
+	+--------------------*/
+	if( (fd = M_open( devName )) < 0 ||
+		M_getstat( fd, M_LL_CH_NUMBER, &nbrCh ) ||
+		M_getstat( fd, M22_24_TICK_RATE, &tickRate ) ||
+		(all && chSetup( fd, nbrCh )) ||
+		M_setstat( fd, M22_24_EVENT_COUNT, 0 ) ||
+		M_setstat( fd, M_MK_IRQ_ENABLE, 1 ) ){
+		printf("*** %s: %s\n", devName, M_errstringTs( UOS_ErrnoGet(), buf ) );
+		goto CLEANUP;
+	}
+
+	/* fails without event buffer, size 0 takes no event */
+	blkStruct.size = 0;
+	blkStruct.data = (void*)ev;
+	if( M_getstat( fd, M22_24_GETBLOCK_EVENTS, (int32*)&blkStruct ) ){
+		printf("*** %s: no event buffer, set EVENT_BUF_SIZE\n", devName );
+		goto CLEANUP;
+	}
+
+	/*--------------------+
+	|  file header        |
+	+--------------------*/
+	if( (fp = fopen( fileName, "wb" )) == NULL ){
+		printf("*** can't create %s\n", fileName );
+		goto CLEANUP;
+	}
+
+	memset( &hdr, 0, sizeof(hdr) );
+	hdr.magic		= M22_REC_MAGIC;
+	hdr.version		= M22_REC_VERSION;
+	hdr.recSize		= sizeof(M22_REC_EVENT);
+	hdr.hdrSize		= sizeof(M22_REC_HDR);
+	hdr.tickRate	= (u_int32)tickRate;
+	hdr.nbrCh		= (u_int32)nbrCh;
+	strncpy( hdr.devName, devName, sizeof(hdr.devName) - 1 );
+	if( fwrite( &hdr, sizeof(hdr), 1, fp ) != 1 ){
+		printf("*** can't write %s\n", fileName );
+		goto CLEANUP;
+	}
+
+	printf("recording %s (%d channels, %d ticks/s) into %s\n", devName,
+		   (int)nbrCh, (int)tickRate, fileName );
+
+	/*--------------------+
+	|  record             |
+	+--------------------*/
+	start = UOS_MsecTimerGet();
+	for(;;){
+		elapsed = UOS_MsecTimerGet() - start;
+		if( (maxEvents && count >= maxEvents) ||
+			(maxSec && elapsed >= maxSec * 1000) ||
+			UOS_KeyPressed() != -1 )
+			break;
+
+		/* block until the first event, take the rest at once */
+		wt.timeout = REC_WAIT_MS;
+		blkStruct.size = sizeof(wt);
+		blkStruct.data = (void*)&wt;
+		if( M_getstat( fd, M22_24_GETBLOCK_WAIT_EVENT, (int32*)&blkStruct ) ){
+			if( UOS_ErrnoGet() == ERR_OSS_TIMEOUT )
+				continue;
+			printf("*** wait event: %s\n", M_errstringTs( UOS_ErrnoGet(), buf ) );
+			goto CLEANUP;
+		}
+		ev[0] = wt.ev;
+
+		blkStruct.size = (REC_BLOCK - 1) * sizeof(*ev);
+		blkStruct.data = (void*)&ev[1];
+		if( M_getstat( fd, M22_24_GETBLOCK_EVENTS, (int32*)&blkStruct ) ){
+			printf("*** get events: %s\n", M_errstringTs( UOS_ErrnoGet(), buf ) );
+			goto CLEANUP;
+		}
+		n = 1 + blkStruct.size / (int32)sizeof(*ev);
+
+		if( maxEvents && count + n > maxEvents )
+			n = (int32)(maxEvents - count);
+
+		for( i = 0; i < (u_int32)n; i++ ){
+			if( count + i && ev[i].seqNbr != nextSeq )
+				lost += ev[i].seqNbr - nextSeq;
+			nextSeq = ev[i].seqNbr + 1;
+		}
+
+		if( fwrite( ev, sizeof(*ev), n, fp ) != (size_t)n ){
+			printf("*** can't write %s\n", fileName );
+			goto CLEANUP;
+		}
+		count += n;
+	}
+
+	/*--------------------+
+	|  final header       |
+	+--------------------*/
+	hdr.nbrEvents = count;
+	hdr.lost	  = lost;
+	if( fseek( fp, 0, SEEK_SET ) ||
+		fwrite( &hdr, sizeof(hdr), 1, fp ) != 1 ){
+		printf("*** can't write %s\n", fileName );
+		goto CLEANUP;
+	}
+
+	printf("%u events in %u ms, %u lost\n", (unsigned)count,
+		   (unsigned)elapsed, (unsigned)lost );
+	error = 0;
+
+CLEANUP:
+	if( fp )
+		fclose( fp );
+	if( fd >= 0 )
+		M_close( fd );
+	free( ev );
+
+	return( error );
+}
+
+/********************************* chSetup **********************************
+ *
+ *  Description:  Activate all channels with both edges.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  fd      path
+ *                nbrCh   number of channels
+ *  Output.....:  return  0 | -1
+ *  Globals....:  -
+ ****************************************************************************/
+static int32 chSetup( int32 fd, int32 nbrCh )
+{
+	int32 ch;
+
+	for( ch = 0; ch < nbrCh; ch++ ){
+		if( M_setstat( fd, M_MK_CH_CURRENT, ch ) ||
+			M_setstat( fd, M22_24_CHANNEL_INACTIVE, 0 ) ||
+			M_setstat( fd, M22_24_INPUT_EDGE_MASK,
+					   M22_24_RISING_EDGE_ENABLE | M22_24_FALLING_EDGE_ENABLE ) )
+			return( -1 );
+	}
+
+	return( 0 );
+}
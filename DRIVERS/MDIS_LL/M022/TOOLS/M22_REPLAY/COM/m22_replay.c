@@ -0,0 +1,326 @@
+/*********************  P r o g r a m  -  M o d u l e ***********************
+ *
+ *         Name: m22_replay.c
+ *      Project: MDIS 4.x
+ *
+ *  Description: replays an m22_rec recording onto the M22 outputs
+ *
+ *               The input edges of the recording switch the M22 outputs
+ *               with the recorded timing (optionally scaled by -s).
+ *               Edges with the same time stamp are written together with
+ *               one M22_PORT_OUTPUTS_MODIFY, unless a channel switches
+ *               twice. Recorded channels 0..7 are replayed on the M22
+ *               channels 0..7, -c=8 replays channels 8..15 of an M24
+ *               recording instead. Records of other channels are skipped
+ *               and counted. Alarm events are skipped.
+ *               The replayed outputs are switched off at start and end.
+ *
+ *     Required: -
+ *     Switches: -
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <MEN/men_typs.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <MEN/usr_oss.h>
+#include <MEN/mdis_api.h>
+#include <MEN/mdis_err.h>
+
+#include <MEN/m22_drv.h>
+#include <MEN/m22_rec.h>
+
+static const char IdentString[]=MENT_XSTR(MAK_REVISION);
+
+/*-----------------------------------------+
+|  DEFINES & CONST                         |
++------------------------------------------*/
+#define REPLAY_BLOCK	256			/* records per read */
+
+/* byte swapped magic: recorded on a host of other byte order */
+#define M22_REC_MAGIC_SWAPPED	0x4d323252
+
+/*-----------------------------------------+
+|  STATICS                                 |
++------------------------------------------*/
+static int32	G_fd = -1;
+static u_int32	G_set, G_clr;		/* pending output changes */
+static u_int32	G_writes;			/* M22_PORT_OUTPUTS_MODIFY calls */
+static u_int32	G_late;				/* writes more than 1ms late */
+
+/*-----------------------------------------+
+|  PROTOTYPES                              |
++------------------------------------------*/
+static void usage( void );
+static int32 outFlush( void );
+static int32 replay( FILE *fp, M22_REC_HDR *hdr, u_int32 chMask,
+					 u_int32 firstCh, u_int32 speed, u_int32 *countP,
+					 u_int32 *skipP );
+
+/********************************* usage ************************************
+ *
+ *  Description:  Print program usage.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  -
+ *  Globals....:  -
+ ****************************************************************************/
+static void usage( void )
+{
+	printf("usage: m22_replay [<opts>] <device m22> <file>\n");
+	printf("Function: replay an m22_rec recording onto the M22 outputs\n");
+	printf("Options:\n");
+	printf("    -s=<speed>   speed [%%] .................... [100]\n");
+	printf("    -l=<loops>   number of loops, 0 = endless .. [1]\n");
+	printf("    -m=<mask>    replayed M22 channels ......... [0xff]\n");
+	printf("    -c=<ch>      recorded channel replayed on\n");
+	printf("                 M22 channel 0 ................. [0]\n");
+	printf("%s\n", IdentString );
+	printf("(c) 2026 by MEN mikro elektronik GmbH\n\n");
+}
+
+/********************************* main *************************************
+ *
+ *  Description:  Check the recording and replay it.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  argc, argv   [<opts>] <m22 device> <file>
+ *  Output.....:  return       0 = ok, 1 = error
+ *  Globals....:  -
+ ****************************************************************************/
+int main( int argc, char *argv[] )
+{
+	char		*devName = NULL, *fileName = NULL;
+	char		buf[UOS_ERRSTRING_SIZE];
+	u_int32		speed = 100, loops = 1, chMask = 0xff, firstCh = 0;
+	u_int32		loop, count, skip, i;
+	int32		ch, error = 1;
+	FILE		*fp = NULL;
+	M22_REC_HDR	hdr;
+
+	for( i = 1; i < (u_int32)argc; i++ ){
+		if( !strncmp( argv[i], "-s=", 3 ) )
+			speed = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-l=", 3 ) )
+			loops = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+		else if( !strncmp( argv[i], "-m=", 3 ) )
+			chMask = (u_int32)strtoul( argv[i] + 3, NULL, 0 ) & 0xff;
+		else if( !strncmp( argv[i], "-c=", 3 ) )
+			firstCh = (u_int32)strtoul( argv[i] + 3, NULL, 0 );
+		else if( argv[i][0] == '-' ){
+			usage();
+			return( 1 );
+		}
+		else if( devName == NULL )
+			devName = argv[i];
+		else if( fileName == NULL )
+			fileName = argv[i];
+	}
+
+	if( devName == NULL || fileName == NULL || speed == 0 ){
+		usage();
+		return( 1 );
+	}
+
+	/*--------------------+
+	|  check recording    |
+	+--------------------*/
+	if( (fp = fopen( fileName, "rb" )) == NULL ||
+		fread( &hdr, sizeof(hdr), 1, fp ) != 1 ){
+		printf("*** can't read %s\n", fileName );
+		goto CLEANUP;
+	}
+
+	if( hdr.magic == M22_REC_MAGIC_SWAPPED ){
+		printf("*** %s: recorded with other byte order\n", fileName );
+		goto CLEANUP;
+	}
+	if( hdr.magic != M22_REC_MAGIC || hdr.version > M22_REC_VERSION ||
+		hdr.recSize != sizeof(M22_REC_EVENT) ||
+		hdr.hdrSize < sizeof(M22_REC_HDR) ){
+		printf("*** %s: no m22_rec file or unsupported version %u\n",
+			   fileName, (unsigned)hdr.version );
+		goto CLEANUP;
+	}
+	if( hdr.tickRate == 0 ){
+		printf("*** %s: illegal tick rate\n", fileName );
+		goto CLEANUP;
+	}
+
+	hdr.devName[sizeof(hdr.devName) - 1] = '\0';
+	printf("%s: %s, %u events, %u lost, %u ticks/s\n", fileName,
+		   hdr.devName, (unsigned)hdr.nbrEvents, (unsigned)hdr.lost,
+		   (unsigned)hdr.tickRate );
+
+	/*--------------------+
+	|  open M22           |
+	+--------------------*/
+	if( (G_fd = M_open( devName )) < 0 ){
+		printf("*** %s: %s\n", devName, M_errstringTs( UOS_ErrnoGet(), buf ) );
+		goto CLEANUP;
+	}
+	for( ch = 0; ch < M22_MAX_CH; ch++ ){
+		if( !(chMask & (1 << ch)) )
+			continue;
+		if( M_setstat( G_fd, M_MK_CH_CURRENT, ch ) ||
+			M_setstat( G_fd, M22_24_CHANNEL_INACTIVE, 0 ) ){
+			printf("*** %s ch %d: %s\n", devName, (int)ch,
+				   M_errstringTs( UOS_ErrnoGet(), buf ) );
+			goto CLEANUP;
+		}
+	}
+
+	/*--------------------+
+	|  replay             |
+	+--------------------*/
+	for( loop = 1; loops == 0 || loop <= loops; loop++ ){
+		G_clr = chMask;
+		if( outFlush() ||
+			fseek( fp, (long)hdr.hdrSize, SEEK_SET ) ||
+			replay( fp, &hdr, chMask, firstCh, speed, &count, &skip ) ){
+			printf("*** replay: %s\n", M_errstringTs( UOS_ErrnoGet(), buf ) );
+			goto CLEANUP;
+		}
+		printf("loop %u: %u edges, %u writes, %u late, %u skipped\n",
+			   (unsigned)loop, (unsigned)count, (unsigned)G_writes,
+			   (unsigned)G_late, (unsigned)skip );
+		if( UOS_KeyPressed() != -1 )
+			break;
+	}
+	error = 0;
+
+CLEANUP:
+	if( G_fd >= 0 ){
+		G_set = 0;
+		G_clr = chMask;
+		outFlush();
+		M_close( G_fd );
+	}
+	if( fp )
+		fclose( fp );
+
+	return( error );
+}
+
+/********************************* outFlush *********************************
+ *
+ *  Description:  Write the pending output changes.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  -
+ *  Output.....:  return  0 | -1
+ *  Globals....:  G_fd, G_set, G_clr, G_writes
+ ****************************************************************************/
+static int32 outFlush( void )
+{
+	if( !(G_set | G_clr) )
+		return( 0 );
+
+	if( M_setstat( G_fd, M22_PORT_OUTPUTS_MODIFY,
+				   M22_OUT_MODIFY( G_set, G_clr, 0 ) ) )
+		return( -1 );
+
+	G_set = G_clr = 0;
+	G_writes++;
+	return( 0 );
+}
+
+/********************************* replay ***********************************
+ *
+ *  Description:  Replay the records once.
+ *
+ *                The output time of a record is its time stamp distance to
+ *                the first record, scaled by 100/speed. Waits are done
+ *                with UOS_Delay() against UOS_MsecTimerGet(), so errors
+ *                don't add up.
+ *                Recorded channel firstCh+n is replayed on M22 channel n,
+ *                records of channels outside firstCh..firstCh+7 are
+ *                skipped.
+ *
+ *---------------------------------------------------------------------------
+ *  Input......:  fp      recording, positioned at the first record
+ *                hdr     file header
+ *                chMask  replayed M22 channels
+ *                firstCh recorded channel replayed on M22 channel 0
+ *                speed   speed [%]
+ *                countP  replayed edges
+ *                skipP   records of unmapped channels
+ *  Output.....:  return  0 | -1
+ *  Globals....:  G_set, G_clr, G_writes, G_late
+ ****************************************************************************/
+static int32 replay( FILE *fp, M22_REC_HDR *hdr, u_int32 chMask,
+					 u_int32 firstCh, u_int32 speed, u_int32 *countP,
+					 u_int32 *skipP )
+{
+	M22_REC_EVENT	rec[REPLAY_BLOCK];
+	u_int32			t0 = 0, lastTs = 0, start, due, now, ch, bit, i;
+	size_t			n;
+	int				first = 1;
+
+	*countP = *skipP = 0;
+	G_writes = G_late = 0;
+	start = UOS_MsecTimerGet();
+
+	while( (n = fread( rec, sizeof(rec[0]), REPLAY_BLOCK, fp )) > 0 ){
+		for( i = 0; i < n; i++ ){
+			if( rec[i].flags & M22_EV_ALARM )
+				continue;
+			ch = (u_int32)rec[i].ch - firstCh;
+			if( ch >= M22_MAX_CH ){
+				(*skipP)++;
+				continue;
+			}
+			bit = 1 << ch;
+			if( !(chMask & bit) )
+				continue;
+
+			if( first ){
+				t0 = lastTs = rec[i].timeStamp;
+				first = 0;
+			}
+
+			/* new time stamp or channel switching twice: write */
+			if( rec[i].timeStamp != lastTs || ((G_set | G_clr) & bit) ){
+				if( outFlush() )
+					return( -1 );
+				lastTs = rec[i].timeStamp;
+
+				due = (u_int32)((u_int64)(lastTs - t0) * 1000 * 100 /
+								((u_int64)hdr->tickRate * speed));
+				now = UOS_MsecTimerGet() - start;
+				if( now < due )
+					UOS_Delay( due - now );
+				else if( now > due + 1 )
+					G_late++;
+			}
+
+			if( rec[i].flags & M22_24_READ_RISING_EDGE )
+				G_set |= bit;
+			else
+				G_clr |= bit;
+			(*countP)++;
+		}
+	}
+
+	return( outFlush() );
+}
@@ -38,6 +38,125 @@
 /*-----------------------------------------+
 |  TYPEDEFS								   |
 +------------------------------------------*/
+/* edge event record (M22_24_GETBLOCK_EVENTS) */
+typedef struct m22_24_event
+{
+	u_int32		seqNbr;			/* event sequence number (gaps = lost events) */
+	u_int32		timeStamp;		/* OSS tick count, see M22_24_TICK_RATE */
+	u_int8		ch;				/* channel 0..7..15 */
+	u_int8		flags;			/* M22_24_READ_xxx | M22_EV_ALARM */
+	u_int16		reserved;
+} M22_24_EVENT;
+
+/* wait for next event (M22_24_GETBLOCK_WAIT_EVENT) */
+typedef struct
+{
+	int32			timeout;		/* in:  timeout [ms], 0 = no wait, -1 = endless */
+	M22_24_EVENT	ev;				/* out: event */
+} M22_24_WAIT;
+
+/* signal subscriber (M22_24_SETBLOCK_SIG_SUBSCRIBE) */
+typedef struct
+{
+	int32			sigNo;			/* signal number */
+	u_int32			chMask;			/* bit n = channel n, 0 = all channels */
+	u_int32			edgeMask;		/* M22_24_SUB_xxx, 0 = all edges */
+} M22_24_SUBSCRIBE;
+
+/* edge counters of a channel (M22_24_GETBLOCK_COUNTERS) */
+typedef struct
+{
+	u_int64			rising;			/* rising edges */
+	u_int64			falling;		/* falling edges */
+} M22_24_COUNTER;
+
+/* frequency/period measurement of a channel (M22_24_GETBLOCK_MEAS) */
+typedef struct
+{
+	u_int32			gatePeriod;		/* mean period of last gate [us] */
+	u_int32			gatePeriodMin;	/* min. of gatePeriod [us] */
+	u_int32			gatePeriodMax;	/* max. of gatePeriod [us] */
+	u_int32			freq;			/* smoothed frequency [mHz], 0 = stopped */
+	u_int32			nbrGates;		/* number of completed gates */
+} M22_24_MEAS;
+
+/* all channels as bit masks, bit n = channel n (M22_24_GETBLOCK_PORT) */
+typedef struct
+{
+	u_int16			inputs;			/* input values */
+	u_int8			outputs;		/* output switches (M22 only) */
+	u_int8			alarms;			/* alarm values (M22 only) */
+} M22_24_PORT;
+
+/* changed channel record (M22_24_BLK_READ_DELTA) */
+typedef struct
+{
+	u_int8			ch;				/* channel number */
+	u_int8			state;			/* state byte as M22_BlockRead */
+} M22_24_DELTA;
+
+/* value for M22_PORT_OUTPUTS_MODIFY: new = ((old & ~clr) | set) ^ tgl */
+#define	M22_OUT_MODIFY(set,clr,tgl)	\
+	( ((u_int32)(set) & 0xff) | (((u_int32)(clr) & 0xff) << 8) | \
+	  (((u_int32)(tgl) & 0xff) << 16) )
+
+/* vectored configuration entry (M22_24_SETBLOCK_CONFIG) */
+#define	M22_24_CONFIG_MAX		64			/* max. entries per call */
+
+typedef struct
+{
+	int32			ch;				/* channel */
+	int32			code;			/* setstat code */
+	int32			value;			/* setstat value */
+} M22_24_CONFIG;
+
+/* output sequencer (M22_SETBLOCK_SEQ): M22_SEQ followed by the steps */
+#define	M22_SEQ_MAX_STEPS		4096
+#define	M22_SEQ_LOOP			0x01		/* flags: repeat each period */
+
+typedef struct
+{
+	u_int32			time;			/* offset from loop start [ms] */
+	u_int32			mask;			/* output switches, bit n = channel n */
+} M22_SEQ_STEP;
+
+typedef struct
+{
+	u_int32			flags;			/* M22_SEQ_xxx */
+	u_int32			period;			/* loop period [ms] */
+	u_int32			nbrSteps;		/* steps following, 0 = none */
+} M22_SEQ;
+
+/* output sequencer progress (M22_GETBLOCK_SEQ_STATUS) */
+#define	M22_SEQ_IDLE			0			/* not started or stopped */
+#define	M22_SEQ_RUNNING			1
+#define	M22_SEQ_DONE			2			/* all steps output */
+
+typedef struct
+{
+	u_int32			state;			/* M22_SEQ_IDLE/RUNNING/DONE */
+	u_int32			step;			/* next step */
+	u_int32			nbrSteps;		/* steps loaded */
+	u_int32			loops;			/* completed loops */
+	u_int32			underruns;		/* steps output too late */
+} M22_SEQ_STATUS;
+
+/* interrupt statistics (M22_24_GETBLOCK_IRQ_STATS) */
+#define	M22_24_IRQ_HIST_SIZE	16
+
+typedef struct
+{
+	u_int32			irqCount;		/* interrupts */
+	u_int32			irqSpurious;	/* interrupts without edge */
+	u_int32			sigSendErr;		/* signal send failures */
+	u_int32			timeRate;		/* time units per second, 0 = ISR time not
+									   measured (driver without M22_STAT_TIME) */
+	u_int32			timeMin;		/* ISR execution time [time units] */
+	u_int32			timeAvg;
+	u_int32			timeMax;
+	u_int32			timeHist[M22_24_IRQ_HIST_SIZE];	/* [0]: 0, [n]: < 2^n units */
+	u_int32			chIrqCount[16];	/* interrupts with edges per channel */
+} M22_24_IRQ_STATS;
 
 /*-----------------------------------------+
 |  DEFINES & CONST						   |
@@ -56,10 +175,62 @@
 #define	M22_24_CLEAR_INPUT_EDGE				M_DEV_OF+0x06	/*   S: clears input edge of current channel	*/
 #define	M22_GET_ALARM						M_DEV_OF+0x07	/* G  : gets alarm and edges of current channel	*/
 #define	M22_CLEAR_ALARM_EDGE				M_DEV_OF+0x08	/*   S: clears alarm edge of current channel	*/
+#define	M22_24_EVENT_COUNT					M_DEV_OF+0x09	/* G,S: buffered events / 0 flushes buffer	*/
+#define	M22_24_EVENT_LOST					M_DEV_OF+0x0a	/* G,S: events lost by buffer overflow	*/
+#define	M22_24_TICK_RATE					M_DEV_OF+0x0b	/* G  : ticks per second of time stamps	*/
+#define	M22_24_IRQ_MODE						M_DEV_OF+0x0c	/* G,S: interrupt handling mode	*/
+#define	M22_24_SIG_HOLDOFF					M_DEV_OF+0x0d	/* G,S: signal holdoff time [ms]	*/
+#define	M22_24_SIG_THRESHOLD				M_DEV_OF+0x0e	/* G,S: edges per signal	*/
+#define	M22_24_SIG_PENDING					M_DEV_OF+0x0f	/* G  : edges since last call	*/
+#define	M22_24_SIG_UNSUBSCRIBE				M_DEV_OF+0x10	/*   S: removes callers subscription	*/
+#define	M22_24_SIG_SUBSCRIBERS				M_DEV_OF+0x11	/* G  : number of subscribers	*/
+#define	M22_24_COUNTER_MODE					M_DEV_OF+0x12	/* G,S: count edges of current channel	*/
+#define	M22_24_COUNTER_CLEAR				M_DEV_OF+0x13	/*   S: clears counters of current channel	*/
+#define	M22_24_MEAS_MODE					M_DEV_OF+0x14	/* G,S: measurement of current channel	*/
+#define	M22_24_MEAS_GATE					M_DEV_OF+0x15	/* G,S: measurement gate [ms]	*/
+#define	M22_24_MEAS_PERIOD					M_DEV_OF+0x16	/* G  : mean period of last gate [us]	*/
+#define	M22_24_MEAS_PERIOD_MIN				M_DEV_OF+0x17	/* G  : min. gate mean period [us]	*/
+#define	M22_24_MEAS_PERIOD_MAX				M_DEV_OF+0x18	/* G  : max. gate mean period [us]	*/
+#define	M22_24_MEAS_FREQ					M_DEV_OF+0x19	/* G  : frequency [mHz]	*/
+#define	M22_24_MEAS_CLEAR					M_DEV_OF+0x1a	/*   S: restarts measurement of current channel	*/
+#define	M22_24_IRQ_STATS_CLEAR				M_DEV_OF+0x1b	/*   S: clears interrupt statistics	*/
+#define	M22_24_DEBOUNCE_US					M_DEV_OF+0x1c	/* G,S: debounce time of current channel [us]	*/
+#define	M22_24_HYBRID_IRQ_RATE				M_DEV_OF+0x1d	/* G,S: irq rate to switch to polling [1/s]	*/
+#define	M22_24_POLL_PERIOD					M_DEV_OF+0x1e	/* G,S: polling period [ms]	*/
+#define	M22_24_POLL_ACTIVE					M_DEV_OF+0x1f	/* G  : irqs disabled, polling	*/
+#define	M22_24_HYBRID_COUNT					M_DEV_OF+0x20	/* G  : switches to polling	*/
+#define	M22_24_POLL_MODE					M_DEV_OF+0x21	/* G,S: interrupt or polling mode	*/
+#define	M22_24_PORT_INPUTS					M_DEV_OF+0x22	/* G  : inputs of all channels as mask	*/
+#define	M22_PORT_OUTPUTS					M_DEV_OF+0x23	/* G,S: outputs of all channels as mask	*/
+#define	M22_PORT_ALARMS						M_DEV_OF+0x24	/* G  : alarms of all channels as mask	*/
+#define	M22_24_SHADOW_SYNC					M_DEV_OF+0x25	/*   S: reloads register shadow from hw	*/
+#define	M22_PORT_OUTPUTS_MODIFY				M_DEV_OF+0x26	/*   S: set/clear/toggle outputs by mask	*/
+#define	M22_24_BLK_READ_MODE				M_DEV_OF+0x27	/* G,S: all or changed channels only	*/
+#define	M22_24_CACHED_READ					M_DEV_OF+0x28	/* G,S: read inputs from irq image	*/
+#define	M22_SEQ_STOP						M_DEV_OF+0x29	/*   S: stops the output sequencer	*/
+#define	M22_PWM_PERIOD						M_DEV_OF+0x2a	/* G,S: PWM period [ms], 0 = off, min. 10 ticks	*/
+#define	M22_PWM_DUTY						M_DEV_OF+0x2b	/* G,S: PWM duty cycle [1/1000]	*/
+/* M22_PULSE: time rounded up to n ticks, output on for n..n+1 ticks
+   plus timer latency (never shorter than requested), min. 1 tick */
+#define	M22_PULSE							M_DEV_OF+0x2c	/* G,S: output pulse [us] / running	*/
+#define	M22_SIG_PULSE_DONE					M_DEV_OF+0x2d	/* G,S: install(ed) pulse done signal	*/
+#define	M22_SIG_CLR_PULSE_DONE				M_DEV_OF+0x2e	/*   S: deinstall pulse done signal	*/
 
 #define	M22_24_SETBLOCK_CLEAR_INPUT_EDGE M_DEV_BLK_OF+0x00	/*   S: clears input edges of active channels	*/
 #define	M22_GETBLOCK_ALARM				 M_DEV_BLK_OF+0x01	/* G  : gets alarms and edges of active channels*/
 #define	M22_SETBLOCK_CLEAR_ALARM_EDGE	 M_DEV_BLK_OF+0x02	/*   S: clears alarm edges of active channels	*/
+#define	M22_24_GETBLOCK_EVENTS			 M_DEV_BLK_OF+0x03	/* G  : reads and removes buffered events	*/
+#define	M22_24_GETBLOCK_WAIT_EVENT		 M_DEV_BLK_OF+0x04	/* G  : waits for the next event	*/
+#define	M22_24_SETBLOCK_SIG_SUBSCRIBE	 M_DEV_BLK_OF+0x05	/*   S: installs filtered signal	*/
+#define	M22_24_GETBLOCK_COUNTERS		 M_DEV_BLK_OF+0x06	/* G  : gets edge counters of all channels	*/
+#define	M22_24_GETBLOCK_COUNTERS_CLR	 M_DEV_BLK_OF+0x07	/* G  : gets and clears edge counters	*/
+#define	M22_24_GETBLOCK_MEAS			 M_DEV_BLK_OF+0x08	/* G  : gets measurements of all channels	*/
+#define	M22_24_GETBLOCK_IRQ_STATS		 M_DEV_BLK_OF+0x09	/* G  : gets interrupt statistics	*/
+#define	M22_24_GETBLOCK_PORT			 M_DEV_BLK_OF+0x0a	/* G  : gets inputs/outputs/alarms as masks	*/
+#define	M22_SETBLOCK_SEQ				 M_DEV_BLK_OF+0x0b	/*   S: loads and starts output sequencer	*/
+#define	M22_GETBLOCK_SEQ_STATUS			 M_DEV_BLK_OF+0x0c	/* G  : gets output sequencer progress	*/
+#define	M22_24_SETBLOCK_CONFIG			 M_DEV_BLK_OF+0x0d	/*   S: applies a list of setstats	*/
+#define	M22_24_GETBLOCK_CONFIG_ERR		 M_DEV_BLK_OF+0x0e	/* G  : gets errors of last list	*/
 
 /* channel option flags	*/
 #define	M22_24_RISING_EDGE_ENABLE	0x1			/* irq on rising edge */
@@ -71,6 +242,32 @@
 #define	M22_24_READ_FALLING_EDGE	0x04		/* output falling edge occured */
 #define	M22_READ_OUTPUT_SWITCH		0x80		/* output falling edge occured */
 
+/* interrupt handling modes (M22_24_IRQ_MODE) */
+#define	M22_24_IRQ_MODE_INTREG		0			/* channel reported by INTREG */
+#define	M22_24_IRQ_MODE_SCAN		1			/* scan all active channels */
+
+/* polling modes (M22_24_POLL_MODE) */
+#define	M22_24_POLL_MODE_IRQ		0			/* edge interrupts */
+#define	M22_24_POLL_MODE_POLL		1			/* polling timer, no irqs */
+
+/* block read modes (M22_24_BLK_READ_MODE) */
+#define	M22_24_BLK_READ_FULL		0			/* all active channels */
+#define	M22_24_BLK_READ_DELTA		1			/* changed channels, M22_24_DELTA */
+
+/* measurement modes (M22_24_MEAS_MODE) */
+#define	M22_24_MEAS_OFF				0			/* no measurement */
+#define	M22_24_MEAS_RISING			1			/* period of rising edges */
+#define	M22_24_MEAS_FALLING			2			/* period of falling edges */
+
+/* event record flags (M22_24_READ_xxx plus) */
+#define	M22_EV_ALARM				0x10		/* alarm edge (M22 only) */
+
+/* subscriber edge filter, input and alarm edges if none of both is set */
+#define	M22_24_SUB_RISING			M22_24_READ_RISING_EDGE		/* rising edges */
+#define	M22_24_SUB_FALLING			M22_24_READ_FALLING_EDGE	/* falling edges */
+#define	M22_24_SUB_INPUT			0x08		/* input edges */
+#define	M22_SUB_ALARM				M22_EV_ALARM	/* alarm edges (M22 only) */
+
 
 /*-----------------------------------------+
 |  GLOBALS								   |
@@ -84,6 +281,8 @@
 #	ifndef _ONE_NAMESPACE_PER_DRIVER_
 #		ifdef ID_SW
 #			define M22_GetEntry M22_SW_GetEntry
+#		elif defined(M22_NO_IRQ)
+#			define M22_GetEntry M22_NIRQ_GetEntry
 #		endif
 		extern void	M22_GetEntry( LL_ENTRY*	drvP );
 #	else
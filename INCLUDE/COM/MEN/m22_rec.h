@@ -0,0 +1,72 @@
+/***********************  I n c l u d e  -  F i l e  ************************
+ *
+ *         Name: m22_rec.h
+ *
+ *  Description: File format of the M22/M24 edge event recorder
+ *               (m22_rec, m22_replay)
+ *
+ *               A recording is one M22_REC_HDR followed by fixed size
+ *               M22_REC_EVENT records in host byte order. A reader
+ *               detects a foreign byte order by the swapped magic.
+ *               Records are the driver's event records: gaps in seqNbr
+ *               are events lost in the driver, timeStamp counts ticks of
+ *               tickRate per second.
+ *
+ *     Switches: -
+ *
+ *---------------------------------------------------------------------------
+ * Copyright 2026, MEN Mikro Elektronik GmbH
+ ****************************************************************************/
+/*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _M22_REC_H
+#define _M22_REC_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*-----------------------------------------+
+|  DEFINES                                 |
++------------------------------------------*/
+#define M22_REC_MAGIC		0x5232324d	/* "M22R" little endian */
+#define M22_REC_VERSION		1
+
+/*-----------------------------------------+
+|  TYPEDEFS                                |
++------------------------------------------*/
+/* file header, 64 bytes */
+typedef struct
+{
+	u_int32		magic;			/* M22_REC_MAGIC */
+	u_int16		version;		/* M22_REC_VERSION */
+	u_int16		recSize;		/* size of one record */
+	u_int32		hdrSize;		/* size of this header, records follow */
+	u_int32		tickRate;		/* ticks per second of timeStamp */
+	u_int32		nbrCh;			/* channels of the recorded module */
+	u_int32		nbrEvents;		/* records, 0 = unknown (see file size) */
+	u_int32		lost;			/* events lost in the driver */
+	u_int32		reserved;
+	char		devName[32];	/* recorded device */
+} M22_REC_HDR;
+
+/* event record, 12 bytes */
+typedef M22_24_EVENT M22_REC_EVENT;
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif /* _M22_REC_H */